@@ -0,0 +1,118 @@
+#include "arrival_order.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+const int DIGIT_BITS = 8;
+const int BUCKETS = 1 << DIGIT_BITS;
+const int PASSES = 32 / DIGIT_BITS;
+const int PARALLEL_MIN = 1 << 17;   // Smaller inputs sort faster on one thread
+const int CHUNK_MIN = 1 << 15;
+
+// Order-preserving unsigned key: negative arrival times sort first
+inline uint32_t arrival_key(int at) {
+    return (uint32_t)at ^ 0x80000000u;
+}
+
+// fn(c) for every chunk c, chunk 0 on the calling thread
+template <typename Fn>
+void for_each_chunk(int chunks, Fn fn) {
+    vector<thread> pool;
+    for (int c = 1; c < chunks; ++c) pool.push_back(thread(fn, c));
+    fn(0);
+    for (size_t i = 0; i < pool.size(); ++i) pool[i].join();
+}
+
+} // namespace
+
+bool in_arrival_order(const Proc* procs, int n) {
+    for (int i = 1; i < n; ++i) {
+        if (procs[i].at < procs[i - 1].at) return false;
+    }
+    return true;
+}
+
+void arrival_order(const Proc* procs, int n, int* order, ScratchArena* scratch, int threads) {
+    if (n <= 0) return;
+    for (int i = 0; i < n; ++i) order[i] = i;
+    if (in_arrival_order(procs, n)) return;
+
+    vector<uint32_t> key_storage;
+    vector<int> idx_storage;
+    uint32_t* keys;
+    int* idx_tmp;
+    if (scratch) {
+        keys = scratch->alloc_array<uint32_t>(2 * (size_t)n);
+        idx_tmp = scratch->alloc_array<int>(n);
+    } else {
+        key_storage.resize(2 * (size_t)n);
+        idx_storage.resize(n);
+        keys = &key_storage[0];
+        idx_tmp = &idx_storage[0];
+    }
+    uint32_t* key_src = keys;
+    uint32_t* key_dst = keys + n;
+    int* idx_src = order;
+    int* idx_dst = idx_tmp;
+    for (int i = 0; i < n; ++i) key_src[i] = arrival_key(procs[i].at);
+
+    int chunks = 1;
+    if (n >= PARALLEL_MIN) {
+        if (threads <= 0) threads = (int)max(1u, thread::hardware_concurrency());
+        chunks = max(1, min(threads, n / CHUNK_MIN));
+    }
+    int chunk_len = (n + chunks - 1) / chunks;
+    vector<int> offset((size_t)chunks * BUCKETS);
+
+    for (int pass = 0; pass < PASSES; ++pass) {
+        int shift = pass * DIGIT_BITS;
+
+        // 1. Digit histogram per chunk
+        for_each_chunk(chunks, [&](int c) {
+            int* h = &offset[(size_t)c * BUCKETS];
+            fill(h, h + BUCKETS, 0);
+            int lo = c * chunk_len, hi = min(n, lo + chunk_len);
+            for (int i = lo; i < hi; ++i) h[(key_src[i] >> shift) & (BUCKETS - 1)]++;
+        });
+
+        // 2. Exclusive prefix over (digit, chunk); a digit shared by every key
+        //    means this pass would not move anything
+        int start = 0;
+        bool skip = false;
+        for (int d = 0; d < BUCKETS && !skip; ++d) {
+            int digit_total = 0;
+            for (int c = 0; c < chunks; ++c) {
+                int count = offset[(size_t)c * BUCKETS + d];
+                offset[(size_t)c * BUCKETS + d] = start;
+                start += count;
+                digit_total += count;
+            }
+            skip = digit_total == n;
+        }
+        if (skip) continue;
+
+        // 3. Stable scatter: each chunk writes its keys in order to its own slots
+        for_each_chunk(chunks, [&](int c) {
+            int* pos = &offset[(size_t)c * BUCKETS];
+            int lo = c * chunk_len, hi = min(n, lo + chunk_len);
+            for (int i = lo; i < hi; ++i) {
+                int p = pos[(key_src[i] >> shift) & (BUCKETS - 1)]++;
+                key_dst[p] = key_src[i];
+                idx_dst[p] = idx_src[i];
+            }
+        });
+        swap(key_src, key_dst);
+        swap(idx_src, idx_dst);
+    }
+    if (idx_src != order) copy(idx_src, idx_src + n, order);
+}
+
+vector<int> arrival_order(const vector<Proc>& procs, int threads) {
+    vector<int> order(procs.size());
+    if (!procs.empty()) arrival_order(&procs[0], (int)procs.size(), &order[0], 0, threads);
+    return order;
+}
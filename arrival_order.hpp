@@ -0,0 +1,22 @@
+#ifndef ARRIVAL_ORDER_HPP
+#define ARRIVAL_ORDER_HPP
+
+#include <vector>
+#include "scheduler_common.hpp"
+#include "engine_context.hpp"
+
+// Permutation of the processes in (at, index) order: the order a stable sort
+// by arrival time gives, which is what every engine consumes. Built with an
+// LSD radix sort over 32-bit arrival keys that moves (key, index) pairs, not
+// Proc records; passes where all keys share a digit are skipped, and input
+// that is already in arrival order costs one linear check. Large inputs are
+// split across `threads` (<= 0: hardware thread count) with per-thread digit
+// histograms, so the result does not depend on the thread count.
+// Temporary buffers come from `scratch` when given.
+void arrival_order(const Proc* procs, int n, int* order, ScratchArena* scratch = 0, int threads = 0);
+std::vector<int> arrival_order(const std::vector<Proc>& procs, int threads = 0);
+
+// True when arrival times never decrease in input order
+bool in_arrival_order(const Proc* procs, int n);
+
+#endif // ARRIVAL_ORDER_HPP
@@ -0,0 +1,411 @@
+#include "batch_compare.hpp"
+#include "workload_io.hpp"
+#include "result_cache.hpp"
+#include "rr_quantum_search.hpp"
+#include "metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <glob.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+
+// --- FILE LISTING ---
+#ifdef _WIN32
+
+bool list_trace_files(const string& dir_or_glob, vector<string>& files, string& error) {
+    files.clear();
+    DWORD attr = GetFileAttributesA(dir_or_glob.c_str());
+    bool is_dir = attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY);
+    string pattern = is_dir ? dir_or_glob + "\\*" : dir_or_glob;
+    string prefix;
+    size_t slash = pattern.find_last_of("\\/");
+    if (slash != string::npos) prefix = pattern.substr(0, slash + 1);
+
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileA(pattern.c_str(), &fd);
+    if (h == INVALID_HANDLE_VALUE) {
+        error = "no files match " + dir_or_glob;
+        return false;
+    }
+    do {
+        if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) files.push_back(prefix + fd.cFileName);
+    } while (FindNextFileA(h, &fd));
+    FindClose(h);
+    sort(files.begin(), files.end());
+    return true;
+}
+
+#else
+
+static bool is_regular_file(const string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+bool list_trace_files(const string& dir_or_glob, vector<string>& files, string& error) {
+    files.clear();
+    struct stat st;
+    if (stat(dir_or_glob.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(dir_or_glob.c_str());
+        if (!dir) {
+            error = "cannot read directory " + dir_or_glob;
+            return false;
+        }
+        string prefix = dir_or_glob;
+        if (prefix.empty() || prefix[prefix.size() - 1] != '/') prefix += '/';
+        while (dirent* e = readdir(dir)) {
+            string path = prefix + e->d_name;
+            if (e->d_name[0] != '.' && is_regular_file(path)) files.push_back(path);
+        }
+        closedir(dir);
+    } else {
+        glob_t g;
+        int rc = glob(dir_or_glob.c_str(), 0, 0, &g);
+        if (rc == 0) {
+            for (size_t i = 0; i < g.gl_pathc; ++i) {
+                if (is_regular_file(g.gl_pathv[i])) files.push_back(g.gl_pathv[i]);
+            }
+        }
+        globfree(&g);
+        if (rc != 0 && rc != GLOB_NOMATCH) {
+            error = "cannot expand " + dir_or_glob;
+            return false;
+        }
+    }
+    if (files.empty()) {
+        error = "no files match " + dir_or_glob;
+        return false;
+    }
+    sort(files.begin(), files.end());
+    return true;
+}
+
+#endif
+
+string csv_field(const string& text) {
+    if (text.find_first_of(",\"\r\n") == string::npos) return text;
+    string quoted = "\"";
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '"') quoted += '"';
+        quoted += text[i];
+    }
+    return quoted + "\"";
+}
+
+namespace {
+
+// The comparison tool's rows: the five engines (cached), then HRRN and the
+// adaptive RR baseline
+const int ROW_HRRN = ALGO_COUNT;
+const int ROW_RR_ADAPTIVE = ALGO_COUNT + 1;
+const int BATCH_ROWS = ALGO_COUNT + 2;
+
+// Column prefix in the CSV; the first ALGO_COUNT are also the engine label in the metrics
+const char* const ENGINE_LABEL[BATCH_ROWS] = {"fcfs", "sjf_np", "priority_np", "srtf", "rr", "hrrn", "rr_adaptive"};
+
+// Fixed-capacity handoff from the listing thread to the workers
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity)
+        : capacity_(capacity), closed_(false),
+          depth_(metrics().gauge("sched_batch_queue_depth", "Trace files waiting for a batch worker.")) {}
+
+    void push(const string& item) {
+        unique_lock<mutex> lock(m_);
+        not_full_.wait(lock, [&] { return items_.size() < capacity_; });
+        items_.push_back(item);
+        depth_.set((double)items_.size());
+        not_empty_.notify_one();
+    }
+
+    // False once the queue is closed and drained
+    bool pop(string& item) {
+        unique_lock<mutex> lock(m_);
+        not_empty_.wait(lock, [&] { return !items_.empty() || closed_; });
+        if (items_.empty()) return false;
+        item = items_.front();
+        items_.pop_front();
+        depth_.set((double)items_.size());
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> lock(m_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    bool closed_;
+    deque<string> items_;
+    mutex m_;
+    condition_variable not_full_, not_empty_;
+    MetricGauge& depth_;
+};
+
+AlgoResult calculate_algorithm(AlgoId algo, const vector<Proc>& procs, int quantum, EngineContext& ctx) {
+    switch (algo) {
+        case ALGO_FCFS:        return calculate_fcfs(procs, ctx);
+        case ALGO_SJF_NP:      return calculate_sjf_np(procs, ctx);
+        case ALGO_PRIORITY_NP: return calculate_priority_np(procs, ctx);
+        case ALGO_SRTF:        return calculate_srtf(procs, ctx);
+        case ALGO_RR:
+        default:               return calculate_rr(procs, quantum, ctx);
+    }
+}
+
+// Nearest-rank percentile of an ascending vector
+double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    long long rank = (long long)ceil(p * sorted.size()) - 1;
+    if (rank < 0) rank = 0;
+    return sorted[rank];
+}
+
+double mean(const vector<double>& v) {
+    double s = 0.0;
+    for (double x : v) s += x;
+    return v.empty() ? 0.0 : s / v.size();
+}
+
+const size_t MAX_REPORTED_FAILURES = 10;
+
+} // namespace
+
+void record_engine_run(AlgoId algo, long long jobs, double seconds) {
+    struct EngineMetrics {
+        MetricHistogram* seconds;
+        MetricCounter* jobs;
+    };
+    static EngineMetrics* per_engine = [] {
+        static EngineMetrics m[ALGO_COUNT];
+        for (int a = 0; a < ALGO_COUNT; ++a) {
+            string label = string("engine=\"") + ENGINE_LABEL[a] + "\"";
+            m[a].seconds = &metrics().histogram("sched_engine_run_seconds", "Wall time of one engine run.",
+                                                exponential_buckets(0.0001, 4, 10), label);
+            m[a].jobs = &metrics().counter("sched_engine_jobs_total", "Processes simulated by each engine.", label);
+        }
+        return m;
+    }();
+    per_engine[algo].seconds->observe(seconds);
+    per_engine[algo].jobs->add(jobs);
+}
+
+bool run_batch_compare(const BatchCompareOptions& options, BatchCompareSummary& summary, string& error) {
+    vector<string> files;
+    if (!list_trace_files(options.input, files, error)) return false;
+
+    FILE* out = fopen(options.output.c_str(), "w");
+    if (!out) {
+        error = "cannot create " + options.output;
+        return false;
+    }
+    fprintf(out, "file,processes,rr_quantum");
+    for (int a = 0; a < BATCH_ROWS; ++a) {
+        fprintf(out, ",%s_avg_tat,%s_avg_wt", ENGINE_LABEL[a], ENGINE_LABEL[a]);
+    }
+    fprintf(out, ",best\n");
+
+    MetricsSession session;
+    MetricCounter& files_ok = metrics().counter("sched_batch_files_done_total", "Trace files finished by the batch comparison.",
+                                                "result=\"ok\"");
+    MetricCounter& files_failed = metrics().counter("sched_batch_files_done_total",
+                                                    "Trace files finished by the batch comparison.", "result=\"failed\"");
+    metrics().gauge("sched_batch_files", "Trace files in the current batch comparison.").set((double)files.size());
+
+    int threads = options.threads > 0 ? options.threads : (int)max(1u, thread::hardware_concurrency());
+    BoundedQueue queue(2 * threads);
+    ResultCache* cache = default_result_cache();
+
+    mutex cache_mutex;   // ResultCache is not thread-safe
+    mutex report_mutex;  // CSV, aggregates, failures
+    vector<double> wt_values[BATCH_ROWS], tat_values[BATCH_ROWS];
+    long long wins[BATCH_ROWS] = {0};
+    string row_names[BATCH_ROWS];       // Of the rows whose name does not depend on the file
+    summary.files_ok = 0;
+    summary.files_failed = 0;
+    summary.failures.clear();
+    atomic<long long> done(0);
+
+    auto worker = [&]() {
+        EngineContext ctx;  // Per-thread scratch, grows to the largest trace seen
+        vector<Proc> procs;
+        string path, load_error;
+        while (queue.pop(path)) {
+            if (!load_workload_file(path, procs, load_error)) {
+                lock_guard<mutex> lock(report_mutex);
+                summary.files_failed++;
+                if (summary.failures.size() < MAX_REPORTED_FAILURES) summary.failures.push_back(load_error);
+                files_failed.add();
+                done++;
+                continue;
+            }
+
+            int quantum = options.quantum > 0 ? options.quantum
+                                              : find_best_quantum(procs, OBJ_AVG_WT, 0.0, 1).best.quantum;
+            WorkloadHash hash = hash_workload(procs);
+            AlgoResult results[BATCH_ROWS];
+            for (int a = 0; a < ALGO_COUNT; ++a) {
+                ResultCacheKey key = make_cache_key(hash, (AlgoId)a, quantum);
+                bool hit = false;
+                if (cache) {
+                    lock_guard<mutex> lock(cache_mutex);
+                    hit = cache->lookup(key, results[a]);
+                }
+                if (!hit) {
+                    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                    results[a] = calculate_algorithm((AlgoId)a, procs, quantum, ctx);
+                    record_engine_run((AlgoId)a, (long long)procs.size(),
+                                      chrono::duration<double>(chrono::steady_clock::now() - start).count());
+                    if (cache) {
+                        lock_guard<mutex> lock(cache_mutex);
+                        cache->store(key, results[a]);
+                    }
+                }
+            }
+            results[ROW_HRRN] = calculate_hrrn(procs, ctx);
+            results[ROW_RR_ADAPTIVE] = calculate_rr_adaptive(procs, ADAPTIVE_RR_PERCENTILE, ctx);
+
+            double best_wt = results[0].avg_wt;
+            int best = 0;
+            for (int a = 1; a < BATCH_ROWS; ++a) {
+                if (results[a].avg_wt < best_wt) {
+                    best_wt = results[a].avg_wt;
+                    best = a;
+                }
+            }
+
+            // The path can be any length; only the numbers go through snprintf
+            char field[64];
+            string row = csv_field(path);
+            snprintf(field, sizeof(field), ",%d,%d", (int)procs.size(), quantum);
+            row += field;
+            for (int a = 0; a < BATCH_ROWS; ++a) {
+                snprintf(field, sizeof(field), ",%.4f,%.4f", results[a].avg_tat, results[a].avg_wt);
+                row += field;
+            }
+            row += "," + results[best].algo_name + "\n";
+
+            lock_guard<mutex> lock(report_mutex);
+            fputs(row.c_str(), out);
+            summary.files_ok++;
+            files_ok.add();
+            for (int a = 0; a < BATCH_ROWS; ++a) {
+                if (a >= ALGO_COUNT) row_names[a] = results[a].algo_name;
+                wt_values[a].push_back(results[a].avg_wt);
+                tat_values[a].push_back(results[a].avg_tat);
+                if (results[a].avg_wt == best_wt) wins[a]++;  // Ties count for every winner
+            }
+            long long finished = ++done;
+            if (finished % 100 == 0 || finished == (long long)files.size()) {
+                cout << "\rProcessed " << finished << " / " << files.size() << " files" << flush;
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (int i = 0; i < threads; ++i) pool.push_back(thread(worker));
+    for (size_t i = 0; i < files.size(); ++i) queue.push(files[i]);
+    queue.close();
+    for (size_t i = 0; i < pool.size(); ++i) pool[i].join();
+    cout << endl;
+
+    bool write_ok = !ferror(out);
+    if (fclose(out) != 0) write_ok = false;
+    if (!write_ok) {
+        error = "write failed for " + options.output;
+        return false;
+    }
+
+    summary.algos.clear();
+    for (int a = 0; a < BATCH_ROWS; ++a) {
+        sort(wt_values[a].begin(), wt_values[a].end());
+        sort(tat_values[a].begin(), tat_values[a].end());
+        BatchAlgoSummary s;
+        s.algo_name = a < ALGO_COUNT ? algo_display_name((AlgoId)a, options.quantum) : row_names[a];
+        if (a == ALGO_RR && options.quantum <= 0) s.algo_name = "RR (best Q)";
+        s.wins = wins[a];
+        s.mean_wt = mean(wt_values[a]);
+        s.p50_wt = percentile(wt_values[a], 0.50);
+        s.p90_wt = percentile(wt_values[a], 0.90);
+        s.p99_wt = percentile(wt_values[a], 0.99);
+        s.mean_tat = mean(tat_values[a]);
+        s.p50_tat = percentile(tat_values[a], 0.50);
+        s.p90_tat = percentile(tat_values[a], 0.90);
+        s.p99_tat = percentile(tat_values[a], 0.99);
+        summary.algos.push_back(s);
+    }
+    return true;
+}
+
+// --- MENU ENTRY ---
+void run_batch_compare_menu() {
+    cout << "\n<-- Batch Comparison Selected -->" << endl;
+    BatchCompareOptions options;
+    cout << "Trace directory or glob (e.g. traces/*.txt): ";
+    cin >> options.input;
+    cout << "Output CSV file: ";
+    cin >> options.output;
+    cout << "Enter Time Quantum (Q) for Round Robin (0 = best Q per file): ";
+    if (!(cin >> options.quantum) || options.quantum < 0) {
+        cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        options.quantum = 2;
+    }
+    options.threads = 0;
+
+    BatchCompareSummary summary;
+    string error;
+    if (!run_batch_compare(options, summary, error)) {
+        cout << "\nBatch comparison failed: " << error << endl;
+    } else {
+        cout << "\n========================================================" << endl;
+        cout << "|| BATCH COMPARISON: " << summary.files_ok << " FILES ||" << endl;
+        cout << "========================================================" << endl;
+        cout << fixed << setprecision(2);
+        cout << left << setw(16) << "| Algorithm"
+             << right << setw(8) << "| Wins"
+             << right << setw(11) << "| Mean WT" << right << setw(10) << "| P50 WT"
+             << right << setw(10) << "| P90 WT" << right << setw(10) << "| P99 WT"
+             << right << setw(11) << "| Mean TAT" << right << setw(10) << "| P50 TAT"
+             << right << setw(10) << "| P90 TAT" << right << setw(12) << "| P99 TAT |" << endl;
+        cout << string(108, '-') << endl;
+        for (const auto& s : summary.algos) {
+            cout << "| " << left << setw(14) << s.algo_name
+                 << right << setw(8) << s.wins
+                 << right << setw(11) << s.mean_wt << right << setw(10) << s.p50_wt
+                 << right << setw(10) << s.p90_wt << right << setw(10) << s.p99_wt
+                 << right << setw(11) << s.mean_tat << right << setw(10) << s.p50_tat
+                 << right << setw(10) << s.p90_tat << right << setw(10) << s.p99_tat << " |" << endl;
+        }
+        cout << string(108, '-') << endl;
+        cout << "Per-file results written to " << options.output << endl;
+        if (summary.files_failed > 0) {
+            cout << summary.files_failed << " file(s) could not be read:" << endl;
+            for (const auto& f : summary.failures) cout << "  " << f << endl;
+        }
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
@@ -0,0 +1,55 @@
+#ifndef BATCH_COMPARE_HPP
+#define BATCH_COMPARE_HPP
+
+#include <string>
+#include <vector>
+#include "comparison_tool.hpp"
+#include "stream_engine.hpp"
+
+// Trace files named by a directory (every regular file in it) or a glob
+// pattern such as "traces/host*.txt". Sorted by name.
+bool list_trace_files(const std::string& dir_or_glob, std::vector<std::string>& files, std::string& error);
+
+// A file name as a CSV field (RFC 4180): quoted when it holds a comma, quote
+// or line break, with quotes doubled
+std::string csv_field(const std::string& text);
+
+struct BatchCompareOptions {
+    std::string input;      // Directory or glob
+    std::string output;     // Per-file CSV
+    int quantum;            // 0: best Q per file (lowest Avg WT)
+    int threads;            // <= 0: hardware thread count
+};
+
+// Per-algorithm aggregate over all files
+struct BatchAlgoSummary {
+    std::string algo_name;
+    long long wins;                 // Files where it had the lowest Avg WT (ties count for all)
+    double mean_wt, p50_wt, p90_wt, p99_wt;
+    double mean_tat, p50_tat, p90_tat, p99_tat;
+};
+
+struct BatchCompareSummary {
+    long long files_ok;
+    long long files_failed;
+    std::vector<std::string> failures;          // First few "path: reason"
+    std::vector<BatchAlgoSummary> algos;        // One per comparison row: ALGO_FCFS .. ALGO_RR, HRRN, adaptive RR
+};
+
+// Runs the comparison tool's algorithm set on every file (the five engines
+// through the result cache, HRRN and adaptive RR always). Files are handed to
+// worker threads through a bounded queue, so only about two workloads per
+// thread are in memory at once; each file's row is appended to the CSV as
+// soon as it is done. Only the per-file averages are kept for the report.
+// With SIM_METRICS set, progress, queue depth and engine run times are
+// exported while it runs.
+bool run_batch_compare(const BatchCompareOptions& options, BatchCompareSummary& summary, std::string& error);
+
+// Adds one engine run to the live metrics (see metrics.hpp): a run-time
+// histogram and a job counter per engine, whose rate() is jobs per second
+void record_engine_run(AlgoId algo, long long jobs, double seconds);
+
+// Menu entry
+void run_batch_compare_menu();
+
+#endif // BATCH_COMPARE_HPP
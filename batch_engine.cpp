@@ -0,0 +1,257 @@
+#include "batch_engine.hpp"
+#include "simd_kernels.hpp"
+#include "simd_target.hpp"
+#include "arrival_order.hpp"
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+// Per-lane metric totals of one batch
+struct LaneTotals {
+    long long sum_tat[BATCH_LANES];
+    long long sum_wt[BATCH_LANES];
+    int min_tat[BATCH_LANES];
+    int max_tat[BATCH_LANES];
+    int min_wt[BATCH_LANES];
+    int max_wt[BATCH_LANES];
+};
+
+AlgoResult lane_result(const char* name, const LaneTotals& t, int lane, int n) {
+    if (n == 0) return {name, 0.0, 0.0, 0, 0, 0, 0};
+    return {name, (double)t.sum_tat[lane] / n, (double)t.sum_wt[lane] / n,
+            t.min_tat[lane], t.max_tat[lane], t.min_wt[lane], t.max_wt[lane]};
+}
+
+#if SIMD_HAVE_AVX2_PATH
+
+// Metric accumulators shared by both lockstep kernels
+struct LaneAccumulators {
+    __m256i sum_tat_lo, sum_tat_hi, sum_wt_lo, sum_wt_hi;
+    __m256i min_tat, max_tat, min_wt, max_wt;
+};
+
+SIMD_AVX2 inline void acc_init(LaneAccumulators& acc) {
+    acc.sum_tat_lo = acc.sum_tat_hi = acc.sum_wt_lo = acc.sum_wt_hi = _mm256_setzero_si256();
+    acc.min_tat = acc.min_wt = _mm256_set1_epi32(numeric_limits<int>::max());
+    acc.max_tat = acc.max_wt = _mm256_set1_epi32(numeric_limits<int>::min());
+}
+
+// Adds the lanes selected by `mask` (all-ones lanes)
+SIMD_AVX2 inline void acc_add(LaneAccumulators& acc, __m256i tat, __m256i wt, __m256i mask) {
+    __m256i t0 = _mm256_and_si256(tat, mask);
+    __m256i w0 = _mm256_and_si256(wt, mask);
+    acc.sum_tat_lo = _mm256_add_epi64(acc.sum_tat_lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(t0)));
+    acc.sum_tat_hi = _mm256_add_epi64(acc.sum_tat_hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(t0, 1)));
+    acc.sum_wt_lo = _mm256_add_epi64(acc.sum_wt_lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(w0)));
+    acc.sum_wt_hi = _mm256_add_epi64(acc.sum_wt_hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(w0, 1)));
+    acc.min_tat = _mm256_blendv_epi8(acc.min_tat, _mm256_min_epi32(acc.min_tat, tat), mask);
+    acc.max_tat = _mm256_blendv_epi8(acc.max_tat, _mm256_max_epi32(acc.max_tat, tat), mask);
+    acc.min_wt = _mm256_blendv_epi8(acc.min_wt, _mm256_min_epi32(acc.min_wt, wt), mask);
+    acc.max_wt = _mm256_blendv_epi8(acc.max_wt, _mm256_max_epi32(acc.max_wt, wt), mask);
+}
+
+SIMD_AVX2 inline void acc_store(const LaneAccumulators& acc, LaneTotals& out) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.sum_tat), acc.sum_tat_lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.sum_tat + 4), acc.sum_tat_hi);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.sum_wt), acc.sum_wt_lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.sum_wt + 4), acc.sum_wt_hi);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.min_tat), acc.min_tat);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.max_tat), acc.max_tat);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.min_wt), acc.min_wt);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.max_wt), acc.max_wt);
+}
+
+// --- LOCKSTEP FCFS: one vertical max/add per job index ---
+SIMD_AVX2 void fcfs_lockstep_avx2(const InterleavedWorkloads& w, LaneTotals& out) {
+    LaneAccumulators acc;
+    acc_init(acc);
+    __m256i counts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w.count));
+    __m256i ct = _mm256_setzero_si256();
+
+    for (int i = 0; i < w.max_jobs; ++i) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&w.at[i * BATCH_LANES]));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&w.bt[i * BATCH_LANES]));
+        __m256i valid = _mm256_cmpgt_epi32(counts, _mm256_set1_epi32(i));
+
+        ct = _mm256_blendv_epi8(ct, _mm256_add_epi32(_mm256_max_epi32(ct, a), b), valid);
+        __m256i tat = _mm256_sub_epi32(ct, a);
+        acc_add(acc, tat, _mm256_sub_epi32(tat, b), valid);
+    }
+    acc_store(acc, out);
+}
+
+// --- LOCKSTEP SJF (NP) ---
+// Every step scans all job slots once for all lanes, picking per lane the
+// arrived job with the smallest (bt, at, index) - the calculate_sjf_np rule -
+// and the next arrival for lanes that have to idle. Finished jobs get
+// key = INT_MAX so they drop out of both searches.
+SIMD_AVX2 void sjf_lockstep_avx2(const InterleavedWorkloads& w, vector<int>& key, LaneTotals& out) {
+    const int INF = numeric_limits<int>::max();
+    const __m256i inf = _mm256_set1_epi32(INF);
+    const __m256i minus_one = _mm256_set1_epi32(-1);
+    LaneAccumulators acc;
+    acc_init(acc);
+    __m256i t = _mm256_setzero_si256();
+
+    for (;;) {
+        __m256i best_key = inf, best_at = inf, best_idx = minus_one, next_at = inf;
+        for (int j = 0; j < w.max_jobs; ++j) {
+            __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&key[j * BATCH_LANES]));
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&w.at[j * BATCH_LANES]));
+            __m256i pending = _mm256_xor_si256(_mm256_cmpeq_epi32(k, inf), minus_one);
+            __m256i future = _mm256_cmpgt_epi32(a, t);
+            __m256i eligible = _mm256_andnot_si256(future, pending);
+
+            __m256i better = _mm256_or_si256(
+                _mm256_cmpgt_epi32(best_key, k),
+                _mm256_and_si256(_mm256_cmpeq_epi32(best_key, k), _mm256_cmpgt_epi32(best_at, a)));
+            better = _mm256_and_si256(better, eligible);
+            best_key = _mm256_blendv_epi8(best_key, k, better);
+            best_at = _mm256_blendv_epi8(best_at, a, better);
+            best_idx = _mm256_blendv_epi8(best_idx, _mm256_set1_epi32(j), better);
+
+            __m256i upcoming = _mm256_blendv_epi8(inf, a, _mm256_and_si256(future, pending));
+            next_at = _mm256_min_epi32(next_at, upcoming);
+        }
+
+        __m256i found = _mm256_cmpgt_epi32(best_idx, minus_one);
+        __m256i can_idle = _mm256_andnot_si256(found, _mm256_xor_si256(_mm256_cmpeq_epi32(next_at, inf), minus_one));
+        if (_mm256_testz_si256(_mm256_or_si256(found, can_idle), minus_one)) break;
+
+        // Run the selected jobs, or jump idle lanes to their next arrival
+        __m256i finish = _mm256_add_epi32(t, best_key);
+        __m256i tat = _mm256_sub_epi32(finish, best_at);
+        acc_add(acc, tat, _mm256_sub_epi32(tat, best_key), found);
+        t = _mm256_blendv_epi8(t, finish, found);
+        t = _mm256_blendv_epi8(t, next_at, can_idle);
+
+        alignas(32) int picked[BATCH_LANES];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(picked), best_idx);
+        for (int l = 0; l < BATCH_LANES; ++l) {
+            if (picked[l] >= 0) key[picked[l] * BATCH_LANES + l] = INF;
+        }
+    }
+    acc_store(acc, out);
+}
+
+// The lockstep kernels add in int32 lanes, which is exact while the clock
+// stays below INT_MAX: at most the latest arrival plus all bursts. (A burst of
+// INT_MAX would also collide with the finished-job key of the SJF kernel.)
+bool fits_lockstep(const vector<Proc>& procs) {
+    long long total_bt = 0;
+    int max_at = 0;
+    for (size_t i = 0; i < procs.size(); ++i) {
+        if (procs[i].at < 0 || procs[i].bt < 0) return false;
+        total_bt += procs[i].bt;
+        max_at = max(max_at, procs[i].at);
+    }
+    return total_bt + max_at < numeric_limits<int>::max();
+}
+
+// Runs the workloads that fit in groups of up to BATCH_LANES through
+// `lockstep` (which returns the group's totals) and the others through the
+// scalar engine, keeping the results in input order
+template <typename Lockstep>
+void for_each_lane_group(const vector<vector<Proc>>& workloads, vector<AlgoResult>& results, EngineContext& ctx,
+                         AlgoResult (*scalar)(const vector<Proc>&, EngineContext&), Lockstep lockstep,
+                         const char* name) {
+    const vector<Proc>* group[BATCH_LANES];
+    size_t slot[BATCH_LANES];
+    int lanes = 0;
+    for (size_t k = 0; k <= workloads.size(); ++k) {
+        if (k < workloads.size()) {
+            if (!fits_lockstep(workloads[k])) {
+                results[k] = scalar(workloads[k], ctx);
+                continue;
+            }
+            group[lanes] = &workloads[k];
+            slot[lanes++] = k;
+            if (lanes < BATCH_LANES) continue;
+        }
+        if (lanes == 0) continue;
+        const LaneTotals* totals = lockstep(group, lanes);
+        for (int l = 0; l < lanes; ++l) results[slot[l]] = lane_result(name, *totals, l, (int)group[l]->size());
+        lanes = 0;
+    }
+}
+
+#endif // SIMD_HAVE_AVX2_PATH
+
+} // namespace
+
+void interleave_workloads(const vector<Proc>* const* workloads, int lanes,
+                          bool sort_by_arrival, InterleavedWorkloads& out) {
+    out.lanes = lanes;
+    out.max_jobs = 0;
+    for (int l = 0; l < BATCH_LANES; ++l) {
+        out.count[l] = l < lanes ? (int)workloads[l]->size() : 0;
+        out.max_jobs = max(out.max_jobs, out.count[l]);
+    }
+    out.at.assign((size_t)out.max_jobs * BATCH_LANES, 0);
+    out.bt.assign((size_t)out.max_jobs * BATCH_LANES, 0);
+
+    vector<int> order;
+    for (int l = 0; l < lanes; ++l) {
+        const vector<Proc>& p = *workloads[l];
+        if (sort_by_arrival) {
+            order = arrival_order(p);
+        } else {
+            order.resize(p.size());
+            for (size_t i = 0; i < order.size(); ++i) order[i] = (int)i;
+        }
+        for (int i = 0; i < out.count[l]; ++i) {
+            out.at[(size_t)i * BATCH_LANES + l] = p[order[i]].at;
+            out.bt[(size_t)i * BATCH_LANES + l] = p[order[i]].bt;
+        }
+    }
+}
+
+vector<AlgoResult> calculate_fcfs_batch(const vector<vector<Proc>>& workloads) {
+    vector<AlgoResult> results(workloads.size());
+    EngineContext ctx;
+#if SIMD_HAVE_AVX2_PATH
+    if (simd_avx2_available()) {
+        InterleavedWorkloads w;
+        LaneTotals totals;
+        for_each_lane_group(workloads, results, ctx, calculate_fcfs, [&](const vector<Proc>* const* group, int lanes) {
+            interleave_workloads(group, lanes, true, w);
+            fcfs_lockstep_avx2(w, totals);
+            return &totals;
+        }, "FCFS");
+        return results;
+    }
+#endif
+    for (size_t k = 0; k < workloads.size(); ++k) results[k] = calculate_fcfs(workloads[k], ctx);
+    return results;
+}
+
+vector<AlgoResult> calculate_sjf_np_batch(const vector<vector<Proc>>& workloads) {
+    vector<AlgoResult> results(workloads.size());
+    EngineContext ctx;
+#if SIMD_HAVE_AVX2_PATH
+    if (simd_avx2_available()) {
+        InterleavedWorkloads w;
+        LaneTotals totals;
+        vector<int> key;
+        for_each_lane_group(workloads, results, ctx, calculate_sjf_np, [&](const vector<Proc>* const* group, int lanes) {
+            interleave_workloads(group, lanes, false, w);
+
+            // Padding slots start out finished
+            key = w.bt;
+            for (int l = 0; l < BATCH_LANES; ++l) {
+                for (int i = w.count[l]; i < w.max_jobs; ++i) {
+                    key[(size_t)i * BATCH_LANES + l] = numeric_limits<int>::max();
+                }
+            }
+            sjf_lockstep_avx2(w, key, totals);
+            return &totals;
+        }, "SJF (NP)");
+        return results;
+    }
+#endif
+    for (size_t k = 0; k < workloads.size(); ++k) results[k] = calculate_sjf_np(workloads[k], ctx);
+    return results;
+}
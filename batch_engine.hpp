@@ -0,0 +1,32 @@
+#ifndef BATCH_ENGINE_HPP
+#define BATCH_ENGINE_HPP
+
+#include <vector>
+#include "scheduler_common.hpp"
+#include "comparison_tool.hpp"
+
+// Workloads evaluated side by side, one per AVX2 lane (8 x int32)
+const int BATCH_LANES = 8;
+
+// Up to BATCH_LANES workloads interleaved job by job: job i of workload l
+// sits at index i * BATCH_LANES + l. Lanes shorter than max_jobs are padded.
+struct InterleavedWorkloads {
+    int lanes;
+    int max_jobs;
+    int count[BATCH_LANES];
+    std::vector<int> at;
+    std::vector<int> bt;
+};
+
+// sort_by_arrival orders each workload exactly like calculate_fcfs does
+void interleave_workloads(const std::vector<Proc>* const* workloads, int lanes,
+                          bool sort_by_arrival, InterleavedWorkloads& out);
+
+// Batched entry points for Monte-Carlo replications: one AlgoResult per
+// workload, identical to calling calculate_fcfs / calculate_sjf_np on each.
+// Without AVX2 they fall back to those engines, as do workloads whose clock
+// could leave the int32 range.
+std::vector<AlgoResult> calculate_fcfs_batch(const std::vector<std::vector<Proc>>& workloads);
+std::vector<AlgoResult> calculate_sjf_np_batch(const std::vector<std::vector<Proc>>& workloads);
+
+#endif // BATCH_ENGINE_HPP
@@ -0,0 +1,314 @@
+#include "burst_predictor.hpp"
+#include "workload_io.hpp"
+#include "arrival_order.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+// --- PREDICTOR ---
+BurstPredictor::BurstPredictor(const PredictorOptions& options) : options_(options), used_(0) {
+    if (options_.history < 1) options_.history = 1;
+    Entry empty = {0, false, 0.0, 0, 0, 0};
+    table_.assign(16, empty);
+    rings_.assign(table_.size() * options_.history, 0);
+}
+
+size_t BurstPredictor::find(int job_class) const {
+    size_t mask = table_.size() - 1;
+    size_t i = ((unsigned)job_class * 2654435761u) & mask;
+    while (table_[i].used && table_[i].job_class != job_class) i = (i + 1) & mask;
+    return i;
+}
+
+void BurstPredictor::grow() {
+    vector<Entry> old_table;
+    vector<int> old_rings;
+    old_table.swap(table_);
+    old_rings.swap(rings_);
+    Entry empty = {0, false, 0.0, 0, 0, 0};
+    table_.assign(old_table.size() * 2, empty);
+    rings_.assign(table_.size() * options_.history, 0);
+    for (size_t i = 0; i < old_table.size(); ++i) {
+        if (!old_table[i].used) continue;
+        size_t j = find(old_table[i].job_class);
+        table_[j] = old_table[i];
+        copy(old_rings.begin() + i * options_.history, old_rings.begin() + (i + 1) * options_.history,
+             rings_.begin() + j * options_.history);
+    }
+}
+
+double BurstPredictor::predict(int job_class) const {
+    const Entry& e = table_[find(job_class)];
+    if (!e.used) return options_.initial_guess;
+    if (options_.mode == PREDICT_LAST_N) return (double)e.sum / e.count;
+    return e.tau;
+}
+
+void BurstPredictor::observe(int job_class, int burst) {
+    size_t i = find(job_class);
+    if (!table_[i].used) {
+        if (2 * (used_ + 1) > table_.size()) {
+            grow();
+            i = find(job_class);
+        }
+        Entry fresh = {job_class, true, options_.initial_guess, 0, 0, 0};
+        table_[i] = fresh;
+        used_++;
+    }
+    Entry& e = table_[i];
+    e.tau = options_.alpha * burst + (1.0 - options_.alpha) * e.tau;
+
+    int* ring = &rings_[i * options_.history];
+    if (e.count == options_.history) {
+        e.sum -= ring[e.head];
+    } else {
+        e.count++;
+    }
+    ring[e.head] = burst;
+    e.sum += burst;
+    e.head = (e.head + 1) % options_.history;
+}
+
+// --- ENGINES ---
+namespace {
+
+struct ReadyJob {
+    double key;    // Predicted (remaining) burst
+    int at;
+    int idx;
+};
+
+// Min-heap order for std::push_heap / pop_heap
+struct ReadyAfter {
+    bool operator()(const ReadyJob& a, const ReadyJob& b) const {
+        if (a.key != b.key) return a.key > b.key;
+        if (a.at != b.at) return a.at > b.at;
+        return a.idx > b.idx;
+    }
+};
+
+struct RunTotals {
+    long long tat_sum, wt_sum;
+    long long min_tat, max_tat, min_wt, max_wt;
+    double abs_error, error;
+
+    RunTotals()
+        : tat_sum(0), wt_sum(0), min_tat(numeric_limits<long long>::max()),
+          max_tat(numeric_limits<long long>::min()), min_wt(numeric_limits<long long>::max()),
+          max_wt(numeric_limits<long long>::min()), abs_error(0), error(0) {}
+
+    void complete(const Proc& p, long long ct) {
+        long long tat = ct - p.at;
+        long long wt = tat - p.bt;
+        tat_sum += tat;
+        wt_sum += wt;
+        min_tat = min(min_tat, tat);
+        max_tat = max(max_tat, tat);
+        min_wt = min(min_wt, wt);
+        max_wt = max(max_wt, wt);
+    }
+
+    AlgoResult result(const string& name, size_t n) const {
+        if (n == 0) return {name, 0.0, 0.0, 0, 0, 0, 0};
+        return {name, (double)tat_sum / n, (double)wt_sum / n, min_tat, max_tat, min_wt, max_wt};
+    }
+};
+
+// predictor == 0: schedule on the true bursts
+AlgoResult sjf_run(const vector<Proc>& procs, BurstPredictor* predictor, RunTotals& totals, const string& name) {
+    vector<int> order = arrival_order(procs);
+    vector<ReadyJob> heap;
+    size_t n = procs.size(), next = 0;
+    long long t = 0;
+    // Predicts and queues the arrivals before `until`
+    auto admit = [&](long long until) {
+        for (; next < n && procs[order[next]].at < until; ++next) {
+            const Proc& p = procs[order[next]];
+            double key = p.bt;
+            if (predictor) {
+                key = predictor->predict(p.job_class);
+                totals.abs_error += fabs(key - p.bt);
+                totals.error += key - p.bt;
+            }
+            ReadyJob j = {key, p.at, order[next]};
+            heap.push_back(j);
+            push_heap(heap.begin(), heap.end(), ReadyAfter());
+        }
+    };
+    for (size_t done = 0; done < n; ++done) {
+        if (heap.empty() && t < procs[order[next]].at) t = procs[order[next]].at;  // Idle CPU
+        admit(t + 1);
+
+        pop_heap(heap.begin(), heap.end(), ReadyAfter());
+        const Proc& p = procs[heap.back().idx];
+        heap.pop_back();
+        t += max(p.bt, 0);
+        totals.complete(p, t);
+        // Jobs that arrived while it ran are predicted without its burst
+        admit(t);
+        if (predictor) predictor->observe(p.job_class, p.bt);
+    }
+    return totals.result(name, n);
+}
+
+AlgoResult srtf_run(const vector<Proc>& procs, BurstPredictor* predictor, RunTotals& totals, const string& name) {
+    vector<int> order = arrival_order(procs);
+    size_t n = procs.size(), next = 0, done = 0;
+    vector<double> predicted(n);
+    vector<long long> ran(n, 0);
+    vector<ReadyJob> heap;
+    int current = -1;
+    long long t = 0;
+
+    while (done < n) {
+        if (current < 0 && heap.empty() && t < procs[order[next]].at) t = procs[order[next]].at;
+
+        // Every event re-decides: the running job competes with its estimate so far
+        if (current >= 0) {
+            ReadyJob j = {max(predicted[current] - ran[current], 0.0), procs[current].at, current};
+            heap.push_back(j);
+            push_heap(heap.begin(), heap.end(), ReadyAfter());
+        }
+        for (; next < n && procs[order[next]].at <= t; ++next) {
+            int i = order[next];
+            const Proc& p = procs[i];
+            predicted[i] = p.bt;
+            if (predictor) {
+                predicted[i] = predictor->predict(p.job_class);
+                totals.abs_error += fabs(predicted[i] - p.bt);
+                totals.error += predicted[i] - p.bt;
+            }
+            ReadyJob j = {predicted[i], p.at, i};
+            heap.push_back(j);
+            push_heap(heap.begin(), heap.end(), ReadyAfter());
+        }
+        pop_heap(heap.begin(), heap.end(), ReadyAfter());
+        current = heap.back().idx;
+        heap.pop_back();
+
+        // Run until the job finishes or the next arrival
+        long long remaining = max(procs[current].bt, 0) - ran[current];
+        long long run = remaining;
+        if (next < n) run = min(run, procs[order[next]].at - t);
+        t += run;
+        ran[current] += run;
+        if (run == remaining) {
+            totals.complete(procs[current], t);
+            if (predictor) predictor->observe(procs[current].job_class, procs[current].bt);
+            current = -1;
+            done++;
+        }
+    }
+    return totals.result(name, n);
+}
+
+PredictionReport make_report(const vector<Proc>& procs, const PredictorOptions& options, bool preemptive) {
+    PredictionReport r;
+    BurstPredictor predictor(options);
+    RunTotals predicted, oracle;
+    if (preemptive) {
+        r.predicted = srtf_run(procs, &predictor, predicted, "SRTF (predicted)");
+        r.oracle = srtf_run(procs, 0, oracle, "SRTF (oracle)");
+    } else {
+        r.predicted = sjf_run(procs, &predictor, predicted, "SJF NP (predicted)");
+        r.oracle = sjf_run(procs, 0, oracle, "SJF NP (oracle)");
+    }
+    size_t n = max(procs.size(), (size_t)1);
+    r.mean_abs_error = predicted.abs_error / n;
+    r.mean_error = predicted.error / n;
+    r.classes = predictor.classes();
+    return r;
+}
+
+} // namespace
+
+PredictionReport run_sjf_predicted(const vector<Proc>& procs, const PredictorOptions& options) {
+    return make_report(procs, options, false);
+}
+
+PredictionReport run_srtf_predicted(const vector<Proc>& procs, const PredictorOptions& options) {
+    return make_report(procs, options, true);
+}
+
+// --- MENU ENTRY ---
+void run_burst_prediction() {
+    cout << "\n<-- SJF/SRTF with Predicted Burst Times Selected -->" << endl;
+    cout << "(Workload files can add a CLASS column: AT BT PRIORITY CLASS. Jobs of a class share predictions.)" << endl;
+    vector<Proc> procs;
+    if (!prompt_workload(procs)) {
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "\nPress Enter to return to main menu...";
+        cin.get();
+        return;
+    }
+
+    PredictorOptions options;
+    options.alpha = 0.5;
+    options.history = 1;
+    int choice;
+    cout << "Predictor (1=Exponential average, 2=Mean of the last N bursts): ";
+    if (!(cin >> choice) || choice < 1 || choice > 2) {
+        cout << "Invalid predictor. Using the exponential average." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        choice = 1;
+    }
+    options.mode = choice == 1 ? PREDICT_EXP_AVG : PREDICT_LAST_N;
+    if (options.mode == PREDICT_EXP_AVG) {
+        cout << "Alpha (0..1, weight of the latest burst): ";
+        if (!(cin >> options.alpha) || options.alpha < 0 || options.alpha > 1) {
+            cout << "Invalid alpha. Using 0.5." << endl;
+            cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            options.alpha = 0.5;
+        }
+    } else {
+        cout << "N (bursts to average): ";
+        if (!(cin >> options.history) || options.history < 1) {
+            cout << "Invalid N. Using 3." << endl;
+            cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            options.history = 3;
+        }
+    }
+    cout << "Initial guess for a class with no finished job (seconds): ";
+    if (!(cin >> options.initial_guess) || options.initial_guess < 0) {
+        cout << "Invalid guess. Using 5 s." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        options.initial_guess = 5;
+    }
+
+    PredictionReport reports[2] = {run_sjf_predicted(procs, options), run_srtf_predicted(procs, options)};
+
+    clearScreen();
+    cout << "\n========================================================" << endl;
+    cout << "|| PREDICTED vs ORACLE BURST TIMES ||" << endl;
+    cout << "========================================================" << endl;
+    cout << fixed << setprecision(2);
+    cout << left << setw(22) << "| Algorithm"
+         << right << setw(15) << "| Avg TAT (s)"
+         << right << setw(15) << "| Avg WT (s)"
+         << right << setw(15) << "| Max WT (s) |" << endl;
+    cout << "-----------------------------------------------------------------------" << endl;
+    for (const auto& r : reports) {
+        for (const AlgoResult* res : {&r.oracle, &r.predicted}) {
+            cout << "| " << left << setw(20) << res->algo_name
+                 << right << setw(15) << res->avg_tat
+                 << right << setw(15) << res->avg_wt
+                 << right << setw(13) << res->max_wt << " |" << endl;
+        }
+    }
+    cout << "-----------------------------------------------------------------------" << endl;
+    for (const auto& r : reports) {
+        cout << r.predicted.algo_name << " vs oracle: Avg TAT " << showpos << r.predicted.avg_tat - r.oracle.avg_tat
+             << " s, Avg WT " << r.predicted.avg_wt - r.oracle.avg_wt << noshowpos << " s" << endl;
+    }
+    cout << "Prediction error per job: mean |error| " << reports[0].mean_abs_error << " s (SJF), "
+         << reports[1].mean_abs_error << " s (SRTF); bias " << reports[0].mean_error << " s (SJF), "
+         << reports[1].mean_error << " s (SRTF) over " << reports[0].classes << " class(es)" << endl;
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
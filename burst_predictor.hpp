@@ -0,0 +1,70 @@
+#ifndef BURST_PREDICTOR_HPP
+#define BURST_PREDICTOR_HPP
+
+#include <vector>
+#include "comparison_tool.hpp"
+
+enum PredictorMode {
+    PREDICT_EXP_AVG,     // tau' = alpha * burst + (1 - alpha) * tau
+    PREDICT_LAST_N       // Mean of the class's last N bursts
+};
+
+struct PredictorOptions {
+    PredictorMode mode;
+    double alpha;         // PREDICT_EXP_AVG, in [0, 1]
+    int history;          // PREDICT_LAST_N: N >= 1
+    double initial_guess; // Prediction for a class with no finished job yet
+};
+
+// Per-class burst predictions in an open-addressing hash table keyed by
+// Proc::job_class (linear probing, at most half full). predict() and
+// observe() are O(1); the last-N window is a ring with a running sum.
+class BurstPredictor {
+public:
+    explicit BurstPredictor(const PredictorOptions& options);
+
+    double predict(int job_class) const;
+    void observe(int job_class, int burst);   // A job of this class finished
+
+    std::size_t classes() const { return used_; }
+
+private:
+    struct Entry {
+        int job_class;
+        bool used;
+        double tau;          // Exponential average (or the initial guess)
+        long long sum;       // Sum of the bursts in the ring
+        int count;           // Bursts in the ring (<= history)
+        int head;            // Next ring position to overwrite
+    };
+
+    std::size_t find(int job_class) const;   // Slot holding job_class, or the empty slot for it
+    void grow();
+
+    PredictorOptions options_;
+    std::vector<Entry> table_;
+    std::vector<int> rings_;   // history ints per table slot
+    std::size_t used_;
+};
+
+// One predicted-burst run and its oracle twin (same engine, true bursts)
+struct PredictionReport {
+    AlgoResult predicted;
+    AlgoResult oracle;
+    double mean_abs_error;   // |prediction - bt| over all jobs, at the time they arrived
+    double mean_error;       // prediction - bt; > 0 means bursts were overestimated
+    std::size_t classes;
+};
+
+// SJF (non-preemptive) and SRTF ordered by predicted bursts, while jobs still
+// run for their true bt. Predictions are made when a job arrives, from the
+// jobs of its class that have finished by then. In SRTF the running job's
+// estimate is its prediction minus the time it has run, floored at 0.
+// Ties go to the earlier arrival, then input order.
+PredictionReport run_sjf_predicted(const std::vector<Proc>& procs, const PredictorOptions& options);
+PredictionReport run_srtf_predicted(const std::vector<Proc>& procs, const PredictorOptions& options);
+
+// Menu entry
+void run_burst_prediction();
+
+#endif // BURST_PREDICTOR_HPP
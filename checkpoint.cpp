@@ -0,0 +1,254 @@
+#include "checkpoint.hpp"
+#include "result_cache.hpp"
+#include "workload_io.hpp"
+#include "arrival_order.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'C', 'K', '1'};
+const long long CLOCK_CHECK_EVERY = 4096;   // Engine steps between clock reads
+const long long DRAIN_STEP = 1LL << 20;     // Simulated seconds per step once all jobs have arrived
+const uint32_t MAX_TRACE_PATH = 4096;
+
+struct RunState {
+    CheckpointOptions options;
+    WorkloadHash workload;
+    long long cursor;   // Arrivals fed so far, in (at, index) order
+};
+
+template <typename T>
+bool put_raw(FILE* f, const T& v) {
+    return fwrite(&v, sizeof(T), 1, f) == 1;
+}
+
+template <typename T>
+bool get_raw(FILE* f, T& v) {
+    return fread(&v, sizeof(T), 1, f) == 1;
+}
+
+bool write_checkpoint(const RunState& s, const StreamEngine& engine, string& error) {
+    const string& path = s.options.checkpoint_path;
+    string tmp = path + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) {
+        error = "cannot create " + tmp;
+        return false;
+    }
+    uint32_t version = CHECKPOINT_VERSION;
+    uint32_t path_len = (uint32_t)s.options.trace_path.size();
+    bool ok = fwrite(CHECKPOINT_MAGIC, 1, sizeof(CHECKPOINT_MAGIC), f) == sizeof(CHECKPOINT_MAGIC) &&
+              put_raw(f, version) && put_raw(f, s.options.quantum) &&
+              put_raw(f, s.options.interval_seconds) && put_raw(f, s.workload.hash) &&
+              put_raw(f, s.workload.n) && put_raw(f, s.cursor) && put_raw(f, path_len) &&
+              fwrite(s.options.trace_path.data(), 1, path_len, f) == path_len &&
+              engine.write_state(f);
+    if (fclose(f) != 0) ok = false;
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    if (ok) remove(path.c_str());
+#endif
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        remove(tmp.c_str());
+        error = "cannot write checkpoint " + path;
+        return false;
+    }
+    return true;
+}
+
+// Reads everything before the engine state and leaves f there. The state's
+// sizes can only be trusted once the trace is checked against the header.
+bool read_checkpoint_header(FILE* f, const string& path, RunState& s, string& error) {
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    uint32_t version = 0, path_len = 0;
+    bool ok = fread(magic, 1, sizeof(magic), f) == sizeof(magic) &&
+              memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) == 0 &&
+              get_raw(f, version) && version == CHECKPOINT_VERSION &&
+              get_raw(f, s.options.quantum) && get_raw(f, s.options.interval_seconds) &&
+              get_raw(f, s.workload.hash) && get_raw(f, s.workload.n) && get_raw(f, s.cursor) &&
+              get_raw(f, path_len) && path_len <= MAX_TRACE_PATH;
+    if (ok) {
+        s.options.trace_path.resize(path_len);
+        ok = path_len == 0 || fread(&s.options.trace_path[0], 1, path_len, f) == path_len;
+    }
+    if (!ok) {
+        error = path + " is not a valid checkpoint";
+        return false;
+    }
+    s.options.checkpoint_path = path;
+    return true;
+}
+
+bool load_sorted_trace(const string& path, vector<Proc>& procs, vector<int>& order, string& error) {
+    if (!load_workload_file(path, procs, error)) return false;
+    // StreamEngine takes arrivals in (at, index) order
+    order = arrival_order(procs);
+    return true;
+}
+
+// Feeds the remaining arrivals and drains the engine, checkpointing on the way
+bool run_from(RunState& s, const vector<Proc>& procs, const vector<int>& order, StreamEngine& engine,
+              AlgoResult& result, string& error, long long* checkpoints_written) {
+    typedef chrono::steady_clock Clock;
+    Clock::time_point last = Clock::now();
+    bool checkpoints = s.options.interval_seconds > 0;
+    long long written = 0, steps = 0;
+    long long n = (long long)order.size();
+
+    // Called between engine steps; the engine is always in a resumable state there
+    auto maybe_checkpoint = [&]() -> bool {
+        if (!checkpoints || ++steps % CLOCK_CHECK_EVERY != 0) return true;
+        Clock::time_point now = Clock::now();
+        if (chrono::duration<double>(now - last).count() < s.options.interval_seconds) return true;
+        if (!write_checkpoint(s, engine, error)) return false;
+        written++;
+        last = Clock::now();
+        cout << "\rCheckpoint " << written << " saved (" << s.cursor << " / " << n << " arrivals)" << flush;
+        return true;
+    };
+
+    while (s.cursor < n) {
+        int idx = order[s.cursor];
+        engine.feed(procs[idx], idx);
+        s.cursor++;
+        if (!maybe_checkpoint()) return false;
+    }
+    for (long long until = engine.current_time(); !engine.idle();) {
+        until = max(until, engine.current_time()) + DRAIN_STEP;
+        engine.run_until(until);
+        if (!maybe_checkpoint()) return false;
+    }
+    engine.finish();
+    if (written) cout << endl;
+
+    result = engine.result(n);
+    if (checkpoints_written) *checkpoints_written = written;
+    remove(s.options.checkpoint_path.c_str());
+    return true;
+}
+
+} // namespace
+
+bool run_checkpointed(const CheckpointOptions& options, AlgoResult& result, string& error,
+                      long long* checkpoints_written) {
+    vector<Proc> procs;
+    vector<int> order;
+    if (!load_sorted_trace(options.trace_path, procs, order, error)) return false;
+
+    RunState s;
+    s.options = options;
+    s.workload = hash_workload(procs);
+    s.cursor = 0;
+    StreamEngine engine(options.algo, options.quantum);
+    return run_from(s, procs, order, engine, result, error, checkpoints_written);
+}
+
+bool resume_checkpointed(const string& checkpoint_path, AlgoResult& result, string& error,
+                         long long* checkpoints_written) {
+    FILE* f = fopen(checkpoint_path.c_str(), "rb");
+    if (!f) {
+        error = "cannot open " + checkpoint_path;
+        return false;
+    }
+    RunState s;
+    vector<Proc> procs;
+    vector<int> order;
+    bool ok = read_checkpoint_header(f, checkpoint_path, s, error) &&
+              load_sorted_trace(s.options.trace_path, procs, order, error);
+    if (ok) {
+        WorkloadHash current = hash_workload(procs);
+        if (current.hash != s.workload.hash || current.n != s.workload.n || s.cursor < 0 ||
+            s.cursor > (long long)order.size()) {
+            error = s.options.trace_path + " changed since the checkpoint was written";
+            ok = false;
+        }
+    }
+    // Only now is the workload size known to be real, so it can bound the state
+    StreamEngine engine;
+    if (ok && (!engine.read_state(f, (long long)procs.size()) || engine.fed() != s.cursor)) {
+        error = checkpoint_path + " is not a valid checkpoint";
+        ok = false;
+    }
+    fclose(f);
+    if (!ok) return false;
+    s.options.algo = engine.algo();
+    return run_from(s, procs, order, engine, result, error, checkpoints_written);
+}
+
+static void print_checkpointed_result(const AlgoResult& r) {
+    cout << fixed << setprecision(2);
+    cout << "\n" << r.algo_name << ": Avg TAT = " << r.avg_tat << " s, Avg WT = " << r.avg_wt
+         << " s (TAT " << r.min_tat << ".." << r.max_tat << ", WT " << r.min_wt << ".." << r.max_wt << ")" << endl;
+}
+
+// --- MENU ENTRY ---
+void run_checkpointed_simulation() {
+    cout << "\n<-- Long-Running Simulation with Checkpoints Selected -->" << endl;
+    CheckpointOptions options;
+    cout << "Workload file: ";
+    cin >> options.trace_path;
+
+    int choice;
+    cout << "Algorithm (1=FCFS, 2=SJF NP, 3=Priority NP, 4=SRTF, 5=RR): ";
+    if (!(cin >> choice) || choice < 1 || choice > 5) {
+        cout << "Invalid algorithm. Using FCFS." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        choice = 1;
+    }
+    options.algo = (AlgoId)(choice - 1);
+
+    options.quantum = 0;
+    if (options.algo == ALGO_RR) {
+        cout << "Enter Time Quantum (Q) for Round Robin: ";
+        if (!(cin >> options.quantum) || options.quantum <= 0) {
+            cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+            cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            options.quantum = 2;
+        }
+    }
+
+    cout << "Checkpoint file: ";
+    cin >> options.checkpoint_path;
+    cout << "Seconds between checkpoints: ";
+    if (!(cin >> options.interval_seconds) || options.interval_seconds <= 0) {
+        cout << "Invalid interval. Using 60 s." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        options.interval_seconds = 60;
+    }
+
+    AlgoResult r;
+    string error;
+    long long written = 0;
+    if (run_checkpointed(options, r, error, &written)) {
+        print_checkpointed_result(r);
+        cout << written << " checkpoint(s) written. An interrupted run continues with: simulator --resume "
+             << options.checkpoint_path << endl;
+    } else {
+        cout << "\nSimulation failed: " << error << endl;
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
+
+int run_resume_command(const string& checkpoint_path) {
+    AlgoResult r;
+    string error;
+    cout << "Resuming from " << checkpoint_path << endl;
+    if (!resume_checkpointed(checkpoint_path, r, error)) {
+        cerr << "Resume failed: " << error << endl;
+        return 1;
+    }
+    print_checkpointed_result(r);
+    return 0;
+}
@@ -0,0 +1,38 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <string>
+#include "comparison_tool.hpp"
+#include "stream_engine.hpp"
+
+const unsigned CHECKPOINT_VERSION = 2;
+
+struct CheckpointOptions {
+    std::string trace_path;        // Workload file ("AT BT [PRIORITY]" lines)
+    std::string checkpoint_path;
+    AlgoId algo;
+    int quantum;                   // RR only
+    double interval_seconds;       // Wall time between checkpoints; <= 0: never
+};
+
+// Runs one algorithm over a workload file with a StreamEngine, saving the
+// engine state and input cursor to checkpoint_path every interval. The file
+// is replaced atomically (written next to it, then renamed), so an
+// interruption at any point leaves the previous checkpoint usable. It is
+// deleted once the run completes.
+bool run_checkpointed(const CheckpointOptions& options, AlgoResult& result, std::string& error,
+                      long long* checkpoints_written = 0);
+
+// Continues a run from its checkpoint. The trace file named in the checkpoint
+// must be unchanged (checked by content hash); the result is bit-identical to
+// an uninterrupted run.
+bool resume_checkpointed(const std::string& checkpoint_path, AlgoResult& result, std::string& error,
+                         long long* checkpoints_written = 0);
+
+// Menu entry
+void run_checkpointed_simulation();
+
+// Command line: simulator --resume <checkpoint>. Returns the exit code.
+int run_resume_command(const std::string& checkpoint_path);
+
+#endif // CHECKPOINT_HPP
@@ -1,4 +1,11 @@
 #include "comparison_tool.hpp"
+#include "simd_kernels.hpp"
+#include "perf_counters.hpp"
+#include "result_cache.hpp"
+#include "workload_io.hpp"
+#include "rr_quantum_search.hpp"
+#include "kinetic_tournament.hpp"
+#include "arrival_order.hpp"
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
@@ -7,46 +14,61 @@
 #include <map>
 #include <cmath> 
 #include <string> // For std::to_string
+#include <memory>
 
 using namespace std;
 
-// --- FAST FCFS (Non-Visual) ---
-AlgoResult calculate_fcfs(const vector<Proc>& input_procs) {
-    if (input_procs.empty()) return {"FCFS", 0.0, 0.0};
-    vector<Proc> p = input_procs;
-    sort(p.begin(), p.end(), compareByAT);
-
-    int current_time = 0;
-    double total_tat = 0;
-    double total_wt = 0;
+// Averages and extremes from per-process TAT / WT columns
+static AlgoResult summarize_run(const string& name, const int* tat, const int* wt, int n) {
+    MetricSummary t = reduce_metric(tat, n);
+    MetricSummary w = reduce_metric(wt, n);
+    return {name, (double)t.sum / n, (double)w.sum / n, t.min, t.max, w.min, w.max};
+}
 
-    for (size_t i = 0; i < p.size(); ++i) {
-        if (current_time < p[i].at) {
-            current_time = p[i].at;
-        }
+// (at, index) order of the processes: the context's shared one, or built in scratch
+static const int* engine_arrival_order(const vector<Proc>& procs, EngineContext& ctx, ScratchArena& scratch) {
+    const int* shared = ctx.shared_arrival_order(procs);
+    if (shared) return shared;
+    int* order = scratch.alloc_array<int>(procs.size());
+    arrival_order(procs.data(), (int)procs.size(), order, &scratch);
+    return order;
+}
 
-        p[i].ct = current_time + p[i].bt;
-        p[i].tat = p[i].ct - p[i].at;
-        p[i].wt = p[i].tat - p[i].bt;
+// --- FAST FCFS (Non-Visual) ---
+// Equal arrival times run in input order, like the streaming engine
+AlgoResult calculate_fcfs(const vector<Proc>& input_procs, EngineContext& ctx) {
+    if (input_procs.empty()) return {"FCFS", 0.0, 0.0, 0, 0, 0, 0};
+    ScratchArena& scratch = ctx.begin_run();
+    int n = input_procs.size();
+    const int* order = engine_arrival_order(input_procs, ctx, scratch);
 
-        current_time = p[i].ct;
-        total_tat += p[i].tat;
-        total_wt += p[i].wt;
+    // SoA columns in arrival order for the vectorized scan
+    int* at = scratch.alloc_array<int>(n);
+    int* bt = scratch.alloc_array<int>(n);
+    for (int i = 0; i < n; ++i) {
+        at[i] = input_procs[order[i]].at;
+        bt[i] = input_procs[order[i]].bt;
     }
 
-    return {"FCFS", total_tat / p.size(), total_wt / p.size()};
+    FcfsKernelResult k = fcfs_kernel(at, bt, n, nullptr);
+    return {"FCFS", (double)k.tat.sum / n, (double)k.wt.sum / n,
+            k.tat.min, k.tat.max, k.wt.min, k.wt.max};
 }
 
 // --- FAST SJF (Non-Preemptive, Non-Visual) ---
-AlgoResult calculate_sjf_np(const vector<Proc>& input_procs) {
-    if (input_procs.empty()) return {"SJF (NP)", 0.0, 0.0};
-    vector<Proc> p = input_procs;
-    int n = p.size();
-    vector<bool> completed(n, false);
+AlgoResult calculate_sjf_np(const vector<Proc>& input_procs, EngineContext& ctx) {
+    if (input_procs.empty()) return {"SJF (NP)", 0.0, 0.0, 0, 0, 0, 0};
+    ScratchArena& scratch = ctx.begin_run();
+    const Proc* p = input_procs.data();
+    int n = input_procs.size();
+    bool* completed = scratch.alloc_array<bool>(n);
+    fill(completed, completed + n, false);
+    int* tat = scratch.alloc_array<int>(n);
+    int* wt = scratch.alloc_array<int>(n);
+    fill(tat, tat + n, 0);
+    fill(wt, wt + n, 0);
     int current_time = 0;
     int completed_count = 0;
-    double total_tat = 0;
-    double total_wt = 0;
 
     while (completed_count < n) {
         int shortest_job_index = -1;
@@ -81,30 +103,30 @@ AlgoResult calculate_sjf_np(const vector<Proc>& input_procs) {
         } else {
             int i = shortest_job_index;
             current_time += p[i].bt;
-            p[i].ct = current_time;
-            p[i].tat = p[i].ct - p[i].at;
-            p[i].wt = p[i].tat - p[i].bt;
+            tat[i] = current_time - p[i].at;
+            wt[i] = tat[i] - p[i].bt;
             completed[i] = true;
             completed_count++;
-
-            total_tat += p[i].tat;
-            total_wt += p[i].wt;
         }
     }
 
-    return {"SJF (NP)", total_tat / n, total_wt / n};
+    return summarize_run("SJF (NP)", tat, wt, n);
 }
 
 // --- FAST PRIORITY (Non-Preemptive, Non-Visual) ---
-AlgoResult calculate_priority_np(const vector<Proc>& input_procs) {
-    if (input_procs.empty()) return {"Priority (NP)", 0.0, 0.0};
-    vector<Proc> p = input_procs;
-    int n = p.size();
-    vector<bool> completed(n, false);
+AlgoResult calculate_priority_np(const vector<Proc>& input_procs, EngineContext& ctx) {
+    if (input_procs.empty()) return {"Priority (NP)", 0.0, 0.0, 0, 0, 0, 0};
+    ScratchArena& scratch = ctx.begin_run();
+    const Proc* p = input_procs.data();
+    int n = input_procs.size();
+    bool* completed = scratch.alloc_array<bool>(n);
+    fill(completed, completed + n, false);
+    int* tat = scratch.alloc_array<int>(n);
+    int* wt = scratch.alloc_array<int>(n);
+    fill(tat, tat + n, 0);
+    fill(wt, wt + n, 0);
     int current_time = 0;
     int completed_count = 0;
-    double total_tat = 0;
-    double total_wt = 0;
 
     while (completed_count < n) {
         int high_priority_index = -1;
@@ -138,44 +160,56 @@ AlgoResult calculate_priority_np(const vector<Proc>& input_procs) {
         } else {
             int i = high_priority_index;
             current_time += p[i].bt;
-            p[i].ct = current_time;
-            p[i].tat = p[i].ct - p[i].at;
-            p[i].wt = p[i].tat - p[i].bt;
+            tat[i] = current_time - p[i].at;
+            wt[i] = tat[i] - p[i].bt;
             completed[i] = true;
             completed_count++;
-
-            total_tat += p[i].tat;
-            total_wt += p[i].wt;
         }
     }
-    return {"Priority (NP)", total_tat / n, total_wt / n};
+    return summarize_run("Priority (NP)", tat, wt, n);
 }
 
 
-// --- FAST SRTF (Preemptive, Non-Visual) ---
-AlgoResult calculate_srtf(const vector<Proc>& input_procs) {
-    if (input_procs.empty()) return {"SRTF (P)", 0.0, 0.0};
+// Scratch record for the preemptive engines (lives in the EngineContext arena)
+struct TempPreemptiveProc {
+    int id; int at; int bt; int rt; int wt; int tat; int final_ct;
+};
+
+// Copies the finished per-process metrics into SoA columns and reduces them
+static AlgoResult summarize_preemptive(const string& name, const TempPreemptiveProc* procs, int n, ScratchArena& scratch) {
+    int* tat = scratch.alloc_array<int>(n);
+    int* wt = scratch.alloc_array<int>(n);
+    for (int i = 0; i < n; ++i) {
+        tat[i] = procs[i].tat;
+        wt[i] = procs[i].wt;
+    }
+    return summarize_run(name, tat, wt, n);
+}
+
+static TempPreemptiveProc* load_preemptive_procs(const vector<Proc>& input_procs, ScratchArena& scratch) {
     int n = input_procs.size();
-    
-    // Using a simple struct to track remaining time and results
-    struct TempSRTFProc {
-        int id; int at; int bt; int rt; int wt = 0; int tat = 0; int final_ct = 0;
-    };
-    vector<TempSRTFProc> srtf_procs;
-    for (const auto& proc : input_procs) {
-        // C++11 compatibility fix
-        TempSRTFProc new_srtf_proc;
-        new_srtf_proc.id = proc.no;
-        new_srtf_proc.at = proc.at;
-        new_srtf_proc.bt = proc.bt;
-        new_srtf_proc.rt = proc.bt;
-        srtf_procs.push_back(new_srtf_proc);
+    TempPreemptiveProc* procs = scratch.alloc_array<TempPreemptiveProc>(n);
+    for (int i = 0; i < n; ++i) {
+        procs[i].id = input_procs[i].no;
+        procs[i].at = input_procs[i].at;
+        procs[i].bt = input_procs[i].bt;
+        procs[i].rt = input_procs[i].bt;
+        procs[i].wt = 0;
+        procs[i].tat = 0;
+        procs[i].final_ct = 0;
     }
+    return procs;
+}
+
+// --- FAST SRTF (Preemptive, Non-Visual) ---
+AlgoResult calculate_srtf(const vector<Proc>& input_procs, EngineContext& ctx) {
+    if (input_procs.empty()) return {"SRTF (P)", 0.0, 0.0, 0, 0, 0, 0};
+    int n = input_procs.size();
+    ScratchArena& scratch = ctx.begin_run();
+    TempPreemptiveProc* srtf_procs = load_preemptive_procs(input_procs, scratch);
 
     int current_time = 0;
     int completed_count = 0;
-    double total_tat = 0;
-    double total_wt = 0;
 
     while (completed_count < n) {
         int shortest_job_index = -1;
@@ -220,62 +254,55 @@ AlgoResult calculate_srtf(const vector<Proc>& input_procs) {
             if (srtf_procs[i].rt == 0) {
                 srtf_procs[i].final_ct = current_time;
                 srtf_procs[i].tat = srtf_procs[i].final_ct - srtf_procs[i].at;
-                total_tat += srtf_procs[i].tat;
-                total_wt += srtf_procs[i].wt;
                 completed_count++;
             }
         }
     }
-    return {"SRTF (P)", total_tat / n, total_wt / n};
+    return summarize_preemptive("SRTF (P)", srtf_procs, n, scratch);
 }
 
 // --- FAST ROUND ROBIN (Preemptive, Non-Visual) ---
 // Note: Quantum is passed as argument
-AlgoResult calculate_rr(const vector<Proc>& input_procs, int quantum) {
-    if (input_procs.empty() || quantum <= 0) return {"RR (Q=" + to_string(quantum) + ")", 0.0, 0.0};
+AlgoResult calculate_rr(const vector<Proc>& input_procs, int quantum, EngineContext& ctx) {
+    if (input_procs.empty() || quantum <= 0) return {"RR (Q=" + to_string(quantum) + ")", 0.0, 0.0, 0, 0, 0, 0};
     int n = input_procs.size();
-
-    struct TempRRProc {
-        int id; int at; int bt; int rt; int wt = 0; int tat = 0; int final_ct = 0;
+    ScratchArena& scratch = ctx.begin_run();
+    TempPreemptiveProc* rr_procs = load_preemptive_procs(input_procs, scratch);
+
+    // Ready queue as a ring buffer: a job is never queued twice, so n slots suffice
+    int* ready_queue = scratch.alloc_array<int>(n);
+    int queue_head = 0;
+    int queue_size = 0;
+    bool* in_queue = scratch.alloc_array<bool>(n); // Indexed like rr_procs
+    fill(in_queue, in_queue + n, false);
+
+    auto enqueue = [&](int i) {
+        ready_queue[(queue_head + queue_size) % n] = i;
+        queue_size++;
+        in_queue[i] = true;
     };
-    vector<TempRRProc> rr_procs;
-    for (const auto& proc : input_procs) {
-        // C++11 compatibility fix
-        TempRRProc new_rr_proc;
-        new_rr_proc.id = proc.no;
-        new_rr_proc.at = proc.at;
-        new_rr_proc.bt = proc.bt;
-        new_rr_proc.rt = proc.bt;
-        rr_procs.push_back(new_rr_proc);
-    }
-
-    queue<int> ready_queue; 
-    map<int, bool> in_queue; // Maps Process ID (rr_procs index nahi) to a boolean
 
     int current_time = 0;
     int completed_count = 0;
-    double total_tat = 0;
-    double total_wt = 0;
     
     while (completed_count < n) {
         
         // Add arrived processes to queue
         for (int i = 0; i < n; ++i) {
-            if (rr_procs[i].at <= current_time && !in_queue[rr_procs[i].id] && rr_procs[i].rt > 0) {
-                ready_queue.push(i); // Push index
-                in_queue[rr_procs[i].id] = true;
+            if (rr_procs[i].at <= current_time && !in_queue[i] && rr_procs[i].rt > 0) {
+                enqueue(i);
             }
         }
         
-        if (ready_queue.empty()) {
+        if (queue_size == 0) {
             // Handle Idle Time
             int next_arrival = numeric_limits<int>::max();
             bool processes_waiting = false;
-            for(const auto& proc : rr_procs) {
-                if (proc.rt > 0) {
+            for (int i = 0; i < n; ++i) {
+                if (rr_procs[i].rt > 0) {
                     processes_waiting = true;
-                    if (proc.at > current_time && proc.at < next_arrival) {
-                        next_arrival = proc.at;
+                    if (rr_procs[i].at > current_time && rr_procs[i].at < next_arrival) {
+                        next_arrival = rr_procs[i].at;
                     }
                 }
             }
@@ -288,10 +315,10 @@ AlgoResult calculate_rr(const vector<Proc>& input_procs, int quantum) {
         }
 
         // Dequeue and Execute
-        int running_index = ready_queue.front();
-        ready_queue.pop();
-        int running_id = rr_procs[running_index].id;
-        in_queue[running_id] = false;
+        int running_index = ready_queue[queue_head];
+        queue_head = (queue_head + 1) % n;
+        queue_size--;
+        in_queue[running_index] = false;
 
         int run_time = min(rr_procs[running_index].rt, quantum);
 
@@ -310,9 +337,8 @@ AlgoResult calculate_rr(const vector<Proc>& input_procs, int quantum) {
 
             // Check for new arrivals during execution (Crucial for RR)
             for (int i = 0; i < n; ++i) {
-                if (rr_procs[i].at == current_time && !in_queue[rr_procs[i].id] && rr_procs[i].rt > 0) {
-                    ready_queue.push(i);
-                    in_queue[rr_procs[i].id] = true;
+                if (rr_procs[i].at == current_time && !in_queue[i] && rr_procs[i].rt > 0) {
+                    enqueue(i);
                 }
             }
             
@@ -325,68 +351,126 @@ AlgoResult calculate_rr(const vector<Proc>& input_procs, int quantum) {
             // Completed
             rr_procs[running_index].final_ct = current_time;
             rr_procs[running_index].tat = rr_procs[running_index].final_ct - rr_procs[running_index].at;
-            total_tat += rr_procs[running_index].tat;
-            total_wt += rr_procs[running_index].wt;
             completed_count++;
             
         } else {
             // Preempted (Quantum expired) - Add back to the end
-            ready_queue.push(running_index);
-            in_queue[running_id] = true;
+            enqueue(running_index);
         }
     }
     
-    return {"RR (Q=" + to_string(quantum) + ")", total_tat / n, total_wt / n};
+    return summarize_preemptive("RR (Q=" + to_string(quantum) + ")", rr_procs, n, scratch);
 }
 
-
-// --- Main Comparison Function ---
-void run_all_algorithms_comparison() {
-    int n;
-    cout << "\n<-- Algorithm Comparison Tool Selected -->" << endl;
-    cout << "Enter Number of Processes: ";
-    if (!(cin >> n) || n <= 0) {
-        cout << "Invalid number of processes." << endl;
-        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
-        return;
+// --- FAST HRRN (Non-Preemptive, Non-Visual) ---
+// Highest Response Ratio Next: (waiting + bt) / bt, so long jobs age instead
+// of starving behind short ones. Ties go to the earlier arrival.
+AlgoResult calculate_hrrn(const vector<Proc>& input_procs, EngineContext& ctx) {
+    if (input_procs.empty()) return {"HRRN", 0.0, 0.0, 0, 0, 0, 0};
+    ScratchArena& scratch = ctx.begin_run();
+    int n = input_procs.size();
+    const int* order = engine_arrival_order(input_procs, ctx, scratch);
+
+    // Slot k is the k-th arrival
+    int* at = scratch.alloc_array<int>(n);
+    int* bt = scratch.alloc_array<int>(n);
+    for (int k = 0; k < n; ++k) {
+        at[k] = input_procs[order[k]].at;
+        bt[k] = input_procs[order[k]].bt;
     }
-
-    // Get Time Quantum for RR
-    int quantum;
-    cout << "Enter Time Quantum (Q) for Round Robin: ";
-    if (!(cin >> quantum) || quantum <= 0) {
-        cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
-        quantum = 2;
+    int* tat = scratch.alloc_array<int>(n);
+    int* wt = scratch.alloc_array<int>(n);
+
+    KineticTournament ready(scratch, at, bt, n);
+    long long current_time = 0;
+    int next = 0;
+    for (int done = 0; done < n; ++done) {
+        if (ready.empty() && current_time < at[next]) current_time = at[next];  // Idle CPU
+        ready.advance(current_time);
+        while (next < n && at[next] <= current_time) ready.insert(next++);
+
+        int k = ready.top();
+        ready.remove(k);
+        current_time += max(bt[k], 0);
+        tat[k] = (int)(current_time - at[k]);
+        wt[k] = tat[k] - bt[k];
     }
-    
-    vector<Proc> input_processes;
 
-    for (int i = 0; i < n; ++i) {
-        // read_proc function Proc structure return karta hai jo common.cpp se aata hai
-        input_processes.push_back(read_proc(i + 1));
+    return summarize_run("HRRN", tat, wt, n);
+}
+
+// --- ADAPTIVE ROUND ROBIN (Non-Visual) ---
+// Each slice is the given percentile of the ready queue's remaining times,
+// so the quantum follows the workload instead of being picked up front
+AlgoResult calculate_rr_adaptive(const vector<Proc>& input_procs, int percentile, EngineContext& ctx) {
+    ScratchArena& scratch = ctx.begin_run();
+    int n = input_procs.size();
+    const int* order = engine_arrival_order(input_procs, ctx, scratch);
+
+    // Runnable jobs in arrival order; zero-length ones never enter the queue
+    int* at = scratch.alloc_array<int>(n > 0 ? n : 1);
+    int* bt = scratch.alloc_array<int>(n > 0 ? n : 1);
+    int runnable = 0;
+    for (int k = 0; k < n; ++k) {
+        const Proc& p = input_procs[order[k]];
+        if (p.bt <= 0) continue;
+        at[runnable] = p.at;
+        bt[runnable++] = p.bt;
     }
+    QuantumEval e = evaluate_rr_adaptive(at, bt, runnable, n, percentile, OBJ_AVG_WT, 0.0, scratch);
+    return {"RR (Adaptive P" + to_string(e.percentile) + ")", e.avg_tat, e.avg_wt,
+            e.min_tat, e.max_tat, e.min_wt, e.max_wt};
+}
 
-    cout << "\nCalculating results for all algorithms (No Simulation Display)..." << endl;
-    // this_thread::sleep_for(chrono::seconds(1)); // Commented out for faster calculation
+// --- One-shot wrappers (fresh scratch per call) ---
+AlgoResult calculate_fcfs(const vector<Proc>& input_procs) {
+    EngineContext ctx(input_procs.size());
+    return calculate_fcfs(input_procs, ctx);
+}
 
-    vector<AlgoResult> results;
-    
-    // 1. FCFS
-    results.push_back(calculate_fcfs(input_processes));
-    
-    // 2. SJF Non-Preemptive
-    results.push_back(calculate_sjf_np(input_processes));
+AlgoResult calculate_sjf_np(const vector<Proc>& input_procs) {
+    EngineContext ctx(input_procs.size());
+    return calculate_sjf_np(input_procs, ctx);
+}
 
-    // 3. Priority Non-Preemptive
-    results.push_back(calculate_priority_np(input_processes));
-    
-    // 4. SRTF Preemptive
-    results.push_back(calculate_srtf(input_processes));
+AlgoResult calculate_priority_np(const vector<Proc>& input_procs) {
+    EngineContext ctx(input_procs.size());
+    return calculate_priority_np(input_procs, ctx);
+}
 
-    // 5. Round Robin
-    results.push_back(calculate_rr(input_processes, quantum));
-    
-    clearScreen();
+AlgoResult calculate_srtf(const vector<Proc>& input_procs) {
+    EngineContext ctx(input_procs.size());
+    return calculate_srtf(input_procs, ctx);
+}
+
+AlgoResult calculate_rr(const vector<Proc>& input_procs, int quantum) {
+    EngineContext ctx(input_procs.size());
+    return calculate_rr(input_procs, quantum, ctx);
+}
+
+AlgoResult calculate_hrrn(const vector<Proc>& input_procs) {
+    EngineContext ctx(input_procs.size());
+    return calculate_hrrn(input_procs, ctx);
+}
+
+AlgoResult calculate_rr_adaptive(const vector<Proc>& input_procs, int percentile) {
+    EngineContext ctx(input_procs.size());
+    return calculate_rr_adaptive(input_procs, percentile, ctx);
+}
+
+
+// --- Main Comparison Function ---
+// Runs one engine, sampling the counters around it when profiling is on
+template <typename Engine>
+static AlgoResult profiled_run(PerfCounters* counters, vector<PerfSample>& samples, Engine engine) {
+    if (!counters) return engine();
+    counters->start();
+    AlgoResult r = engine();
+    samples.push_back(counters->stop());
+    return r;
+}
+
+void print_comparison_table(const vector<AlgoResult>& results) {
     cout << "\n========================================================" << endl;
     cout << "|| FINAL CPU SCHEDULING ALGORITHM COMPARISON RESULTS ||" << endl;
     cout << "========================================================" << endl;
@@ -395,8 +479,9 @@ void run_all_algorithms_comparison() {
     
     cout << left << setw(20) << "\n| Algorithm"
          << right << setw(15) << "| Avg TAT (s)"
-         << right << setw(15) << "| Avg WT (s) |" << endl;
-    cout << "--------------------------------------------------------" << endl;
+         << right << setw(15) << "| Avg WT (s)"
+         << right << setw(15) << "| Max WT (s) |" << endl;
+    cout << "----------------------------------------------------------------------" << endl;
 
     for (const auto& res : results) {
         // Find minimum waiting time (excluding zero)
@@ -415,11 +500,98 @@ void run_all_algorithms_comparison() {
         cout << format_start
              << "| " << left << setw(18) << res.algo_name
              << right << setw(15) << res.avg_tat
-             << right << setw(15) << res.avg_wt << " |"
+             << right << setw(15) << res.avg_wt
+             << right << setw(13) << res.max_wt << " |"
              << format_end << endl;
     }
     
-    cout << "--------------------------------------------------------" << endl;
+    cout << "----------------------------------------------------------------------" << endl;
+}
+
+void run_all_algorithms_comparison() {
+    cout << "\n<-- Algorithm Comparison Tool Selected -->" << endl;
+    vector<Proc> input_processes;
+    if (!prompt_workload(input_processes)) return;
+
+    // Get Time Quantum for RR
+    int quantum;
+    cout << "Enter Time Quantum (Q) for Round Robin (0 = find the Q with the lowest Avg WT): ";
+    if (!(cin >> quantum) || quantum < 0) {
+        cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        quantum = 2;
+    } else if (quantum == 0) {
+        QuantumSearchResult best = find_best_quantum(input_processes, OBJ_AVG_WT);
+        quantum = best.best.quantum;
+        cout << "Best quantum: Q=" << quantum << " (" << best.curve.size() << " RR evaluations)." << endl;
+    }
+    
+
+    cout << "\nCalculating results for all algorithms (No Simulation Display)..." << endl;
+    // this_thread::sleep_for(chrono::seconds(1)); // Commented out for faster calculation
+
+    vector<AlgoResult> results;
+    EngineContext ctx(input_processes.size()); // Shared scratch for all five engines
+    ctx.share_arrival_order(input_processes);  // Sorted once for FCFS and HRRN
+
+    // Optional hardware counters around each engine (SIM_PERF=1)
+    unique_ptr<PerfCounters> counters;
+    if (perf_profiling_enabled()) counters.reset(new PerfCounters());
+    vector<PerfSample> samples;
+
+    // Unchanged workloads are answered from the on-disk result cache. It is
+    // bypassed while profiling so that every engine really runs.
+    ResultCache* cache = counters ? 0 : default_result_cache();
+    WorkloadHash workload = hash_workload(input_processes);
+    size_t hits_before = cache ? cache->hits() : 0;
+    
+    // 1. FCFS
+    results.push_back(cached_result(cache, workload, ALGO_FCFS, quantum, [&] {
+        return profiled_run(counters.get(), samples, [&] { return calculate_fcfs(input_processes, ctx); });
+    }));
+    
+    // 2. SJF Non-Preemptive
+    results.push_back(cached_result(cache, workload, ALGO_SJF_NP, quantum, [&] {
+        return profiled_run(counters.get(), samples, [&] { return calculate_sjf_np(input_processes, ctx); });
+    }));
+
+    // 3. Priority Non-Preemptive
+    results.push_back(cached_result(cache, workload, ALGO_PRIORITY_NP, quantum, [&] {
+        return profiled_run(counters.get(), samples, [&] { return calculate_priority_np(input_processes, ctx); });
+    }));
+    
+    // 4. SRTF Preemptive
+    results.push_back(cached_result(cache, workload, ALGO_SRTF, quantum, [&] {
+        return profiled_run(counters.get(), samples, [&] { return calculate_srtf(input_processes, ctx); });
+    }));
+
+    // 5. Round Robin
+    results.push_back(cached_result(cache, workload, ALGO_RR, quantum, [&] {
+        return profiled_run(counters.get(), samples, [&] { return calculate_rr(input_processes, quantum, ctx); });
+    }));
+
+    // 6. HRRN (always computed: the result cache is keyed by AlgoId)
+    results.push_back(profiled_run(counters.get(), samples, [&] { return calculate_hrrn(input_processes, ctx); }));
+
+    // 7. Adaptive RR baseline: median remaining time of the ready queue as Q (not cached either)
+    results.push_back(profiled_run(counters.get(), samples, [&] {
+        return calculate_rr_adaptive(input_processes, ADAPTIVE_RR_PERCENTILE, ctx);
+    }));
+    
+    clearScreen();
+    print_comparison_table(results);
+
+    if (cache && cache->hits() > hits_before) {
+        // Only the five AlgoId engines go through the cache; HRRN and adaptive RR always run
+        cout << (cache->hits() - hits_before) << " of " << ALGO_COUNT << " cacheable results (all but HRRN and "
+             << "adaptive RR) reused from the result cache (workload unchanged)." << endl;
+    }
+
+    if (counters) {
+        vector<string> labels;
+        for (const auto& res : results) labels.push_back(res.algo_name);
+        print_perf_table(labels, samples, counters->unavailable_reason());
+    }
     
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
     cout << "\nPress Enter to return to main menu...";
@@ -4,6 +4,7 @@
 #include <vector>
 // Proc structure aur common functions ke liye
 #include "scheduler_common.hpp" 
+#include "engine_context.hpp"
 #include <string> // std::string ke liye
 
 // Structure to hold the result of one algorithm
@@ -11,8 +12,33 @@ struct AlgoResult {
     std::string algo_name;
     double avg_tat;
     double avg_wt;
+    long long min_tat;
+    long long max_tat;
+    long long min_wt;
+    long long max_wt;  // Worst wait: starvation shows up here, not in the average
 };
 
+// Fast (non-visual) engines. The EngineContext overloads reuse the context's
+// scratch memory, so repeated runs allocate nothing once it is warm.
+AlgoResult calculate_fcfs(const std::vector<Proc>& input_procs);
+AlgoResult calculate_sjf_np(const std::vector<Proc>& input_procs);
+AlgoResult calculate_priority_np(const std::vector<Proc>& input_procs);
+AlgoResult calculate_srtf(const std::vector<Proc>& input_procs);
+AlgoResult calculate_rr(const std::vector<Proc>& input_procs, int quantum);
+AlgoResult calculate_hrrn(const std::vector<Proc>& input_procs);
+AlgoResult calculate_rr_adaptive(const std::vector<Proc>& input_procs, int percentile);
+
+AlgoResult calculate_fcfs(const std::vector<Proc>& input_procs, EngineContext& ctx);
+AlgoResult calculate_sjf_np(const std::vector<Proc>& input_procs, EngineContext& ctx);
+AlgoResult calculate_priority_np(const std::vector<Proc>& input_procs, EngineContext& ctx);
+AlgoResult calculate_srtf(const std::vector<Proc>& input_procs, EngineContext& ctx);
+AlgoResult calculate_rr(const std::vector<Proc>& input_procs, int quantum, EngineContext& ctx);
+AlgoResult calculate_hrrn(const std::vector<Proc>& input_procs, EngineContext& ctx);
+AlgoResult calculate_rr_adaptive(const std::vector<Proc>& input_procs, int percentile, EngineContext& ctx);
+
+// Results table of the comparison tool; the lowest Avg WT is highlighted
+void print_comparison_table(const std::vector<AlgoResult>& results);
+
 // Function to run multiple algorithms on the same dataset
 void run_all_algorithms_comparison();
 
@@ -0,0 +1,258 @@
+#include "energy_model.hpp"
+#include "arrival_order.hpp"
+#include "workload_io.hpp"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+// Charges every run segment and idle gap reported by the engine, and keeps
+// the segments of the last ondemand_window for the ondemand governor
+class EnergyMeter : public ScheduleObserver {
+public:
+    EnergyMeter(const EnergyModel& model, int jobs, Governor governor)
+        : model_(model), state_of_(jobs, 0), track_recent_(governor == GOV_ONDEMAND), queried_(0), started_(false), first_(0),
+          last_end_(0), active_j_(0), idle_j_(0), busy_(0), idle_(0), asleep_(0), pstate_time_(model.pstates.size(), 0) {}
+
+    void set_state(int idx, int state) { state_of_[idx] = state; }
+
+    void on_arrival(int, long long t) {
+        if (!started_) {
+            started_ = true;
+            first_ = last_end_ = t;
+        }
+    }
+
+    void on_run(int, int idx, long long start, long long end) {
+        if (start > last_end_) charge_idle(start - last_end_);
+        int s = state_of_[idx];
+        active_j_ += model_.pstates[s].power_w * (end - start);
+        busy_ += end - start;
+        pstate_time_[s] += end - start;
+        last_end_ = max(last_end_, end);
+        if (!track_recent_) return;
+        drop_recent_before(queried_ - model_.ondemand_window);
+        recent_.push_back(make_pair(start, end));
+    }
+
+    void on_preempt(int, int, long long, PreemptReason) {}
+    void on_complete(int, int, long long, long long) {}
+
+    // Share of [now - window, now] the CPU was busy. Asked at each arrival, so
+    // now never goes back; engines may report segments starting after it.
+    double utilisation(long long now) {
+        long long from = now - model_.ondemand_window;
+        queried_ = now;
+        drop_recent_before(from);
+        long long busy = 0;
+        for (size_t i = 0; i < recent_.size() && recent_[i].first < now; ++i) {
+            busy += min(recent_[i].second, now) - max(recent_[i].first, from);
+        }
+        return model_.ondemand_window > 0 ? (double)busy / model_.ondemand_window : 1.0;
+    }
+
+    void fill(EnergyReport& r) const {
+        r.active_j = active_j_;
+        r.idle_j = idle_j_;
+        r.energy_j = active_j_ + idle_j_;
+        r.busy_time = busy_;
+        r.idle_time = idle_;
+        r.asleep_time = asleep_;
+        r.makespan = last_end_ - first_;
+        r.pstate_time = pstate_time_;
+    }
+
+private:
+    void drop_recent_before(long long t) {
+        while (!recent_.empty() && recent_.front().second <= t) recent_.pop_front();
+    }
+
+    // Idle power until the first entry latency, then each sleep state in turn
+    void charge_idle(long long gap) {
+        idle_ += gap;
+        long long t = 0;
+        double power = model_.idle_power_w;
+        for (size_t k = 0; k < model_.sleep.size() && model_.sleep[k].entry_latency < gap; ++k) {
+            long long enter = max(t, model_.sleep[k].entry_latency);
+            idle_j_ += power * (enter - t);
+            t = enter;
+            power = model_.sleep[k].power_w;
+        }
+        idle_j_ += power * (gap - t);
+        if (!model_.sleep.empty() && model_.sleep[0].entry_latency < gap) asleep_ += gap - model_.sleep[0].entry_latency;
+    }
+
+    const EnergyModel& model_;
+    vector<int> state_of_;
+    bool track_recent_;                   // Only ondemand reads utilisation()
+    long long queried_;                   // Latest utilisation() time
+    bool started_;
+    long long first_, last_end_;
+    double active_j_, idle_j_;
+    long long busy_, idle_, asleep_;
+    vector<long long> pstate_time_;
+    deque<pair<long long, long long> > recent_;
+};
+
+int pick_state(Governor governor, const EnergyModel& model, EnergyMeter& meter, long long now) {
+    int slowest = (int)model.pstates.size() - 1;
+    switch (governor) {
+        case GOV_PERFORMANCE: return 0;
+        case GOV_POWERSAVE:   return slowest;
+        case GOV_ONDEMAND:
+        default: {
+            double util = meter.utilisation(now);
+            if (util >= model.ondemand_up_threshold) return 0;
+            // Slowest state that still keeps up with the recent load
+            double needed = util / model.ondemand_up_threshold;
+            int s = slowest;
+            while (s > 0 && model.pstates[s].speed < needed) --s;
+            return s;
+        }
+    }
+}
+
+} // namespace
+
+EnergyModel default_energy_model() {
+    EnergyModel m;
+    PState p[] = {{1.0, 15.0}, {0.75, 8.0}, {0.5, 4.5}};
+    SleepState s[] = {{1, 1.5}, {5, 0.3}};
+    m.pstates.assign(p, p + 3);
+    m.idle_power_w = 3.0;
+    m.sleep.assign(s, s + 2);
+    m.ondemand_window = 10;
+    m.ondemand_up_threshold = 0.8;
+    return m;
+}
+
+const char* governor_name(Governor governor) {
+    switch (governor) {
+        case GOV_PERFORMANCE: return "performance";
+        case GOV_POWERSAVE:   return "powersave";
+        case GOV_ONDEMAND:
+        default:              return "ondemand";
+    }
+}
+
+EnergyReport simulate_energy(const vector<Proc>& procs, AlgoId algo, int quantum, Governor governor,
+                             const EnergyModel& model) {
+    EnergyMeter meter(model, (int)procs.size(), governor);
+    StreamEngine engine(algo, quantum);
+    engine.set_observer(&meter);
+
+    vector<int> order = arrival_order(procs);
+    for (size_t k = 0; k < order.size(); ++k) {
+        int i = order[k];
+        Proc scaled = procs[i];
+        // Schedule up to the arrival first, so ondemand sees the load so far
+        engine.run_until(scaled.at);
+        int s = pick_state(governor, model, meter, scaled.at);
+        meter.set_state(i, s);
+        if (scaled.bt > 0) scaled.bt = (int)min((double)numeric_limits<int>::max(), ceil(scaled.bt / model.pstates[s].speed));
+        engine.feed(scaled, i);
+    }
+    engine.finish();
+
+    EnergyReport r;
+    r.result = engine.result((long long)procs.size());
+    meter.fill(r);
+    r.jobs_per_joule = r.energy_j > 0 ? procs.size() / r.energy_j : 0.0;
+    return r;
+}
+
+// --- MENU ENTRY ---
+void run_energy_report() {
+    cout << "\n<-- Energy Report (DVFS and Sleep States) Selected -->" << endl;
+    vector<Proc> procs;
+    if (!prompt_workload(procs)) {
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "\nPress Enter to return to main menu...";
+        cin.get();
+        return;
+    }
+
+    int quantum;
+    cout << "Enter Time Quantum (Q) for Round Robin: ";
+    if (!(cin >> quantum) || quantum <= 0) {
+        cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        quantum = 2;
+    }
+
+    EnergyModel model = default_energy_model();
+    long long light, deep;
+    cout << "Entry latency of the light and the deep sleep state (seconds, e.g. 1 5): ";
+    if (!(cin >> light >> deep) || light < 0 || deep < light) {
+        cout << "Invalid latencies. Using 1 s and 5 s." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    } else {
+        model.sleep[0].entry_latency = light;
+        model.sleep[1].entry_latency = deep;
+    }
+
+    vector<EnergyReport> reports;
+    for (int g = 0; g < GOV_COUNT; ++g) {
+        for (int a = 0; a < ALGO_COUNT; ++a) {
+            reports.push_back(simulate_energy(procs, (AlgoId)a, quantum, (Governor)g, model));
+        }
+    }
+
+    clearScreen();
+    cout << "\n========================================================" << endl;
+    cout << "|| ENERGY AND THROUGHPUT PER WATT ||" << endl;
+    cout << "========================================================" << endl;
+    cout << fixed << setprecision(2);
+
+    double best = 0;
+    for (const auto& r : reports) best = max(best, r.jobs_per_joule);
+
+    cout << left << setw(14) << "| Governor"
+         << left << setw(16) << "| Algorithm"
+         << right << setw(11) << "| Avg TAT"
+         << right << setw(11) << "| Avg WT"
+         << right << setw(13) << "| Energy (J)"
+         << right << setw(10) << "| Avg W"
+         << right << setw(10) << "| Jobs/J"
+         << right << setw(10) << "| Asleep |" << endl;
+    cout << "-----------------------------------------------------------------------------------------------" << endl;
+    for (const auto& r : reports) {
+        size_t k = &r - &reports[0];
+        bool is_best = r.jobs_per_joule == best;
+        double avg_w = r.makespan > 0 ? r.energy_j / r.makespan : 0.0;
+        double asleep = r.makespan > 0 ? 100.0 * r.asleep_time / r.makespan : 0.0;
+        cout << (is_best ? "\033[1;32m" : "")
+             << "| " << left << setw(12) << governor_name((Governor)(k / ALGO_COUNT))
+             << "| " << left << setw(14) << r.result.algo_name
+             << right << setw(11) << r.result.avg_tat
+             << right << setw(11) << r.result.avg_wt
+             << right << setw(13) << r.energy_j
+             << right << setw(10) << avg_w
+             << right << setw(10) << setprecision(4) << r.jobs_per_joule << setprecision(2)
+             << right << setw(7) << asleep << "% |"
+             << (is_best ? "\033[0m" : "") << endl;
+        if ((k + 1) % ALGO_COUNT == 0) {
+            cout << "-----------------------------------------------------------------------------------------------" << endl;
+        }
+    }
+    cout << "P-states:";
+    for (size_t s = 0; s < model.pstates.size(); ++s) {
+        cout << " " << model.pstates[s].speed * 100 << "% speed at " << model.pstates[s].power_w << " W"
+             << (s + 1 < model.pstates.size() ? "," : ".");
+    }
+    cout << "\nIdle: " << model.idle_power_w << " W, light sleep after " << model.sleep[0].entry_latency << " s at "
+         << model.sleep[0].power_w << " W, deep sleep after " << model.sleep[1].entry_latency << " s at "
+         << model.sleep[1].power_w << " W. Slower states stretch the bursts, so TAT/WT differ by governor." << endl;
+    cout << "All five algorithms keep the CPU busy whenever a job is ready, so their busy and idle periods (and" << endl;
+    cout << "energy) only differ between governors; the governor decides the energy, the algorithm the TAT/WT." << endl;
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
@@ -0,0 +1,63 @@
+#ifndef ENERGY_MODEL_HPP
+#define ENERGY_MODEL_HPP
+
+#include <vector>
+#include "stream_engine.hpp"
+
+// Frequency/power state of the CPU while it runs a job
+struct PState {
+    double speed;     // Work per second relative to the fastest state (1.0)
+    double power_w;
+};
+
+// Idle state entered once the CPU has been idle for entry_latency seconds
+struct SleepState {
+    long long entry_latency;
+    double power_w;
+};
+
+enum Governor {
+    GOV_PERFORMANCE,  // Always the fastest state
+    GOV_POWERSAVE,    // Always the slowest state
+    GOV_ONDEMAND,     // Fastest above up_threshold utilisation, else scaled down with it
+    GOV_COUNT
+};
+
+struct EnergyModel {
+    std::vector<PState> pstates;        // Fastest first
+    double idle_power_w;                // Idle but not yet asleep
+    std::vector<SleepState> sleep;      // Ascending entry latency, deeper (cheaper) later
+    long long ondemand_window;          // Utilisation sampling window (s)
+    double ondemand_up_threshold;       // 0..1
+};
+
+// Three P-states, a light and a deep sleep state
+EnergyModel default_energy_model();
+
+struct EnergyReport {
+    AlgoResult result;                  // On the scaled schedule
+    double energy_j;
+    double active_j;
+    double idle_j;                      // Idle and sleep states
+    long long busy_time;
+    long long idle_time;
+    long long asleep_time;              // Part of idle_time spent in a sleep state
+    long long makespan;                 // First arrival to last completion
+    double jobs_per_joule;
+    std::vector<long long> pstate_time; // Busy time per P-state
+};
+
+// Runs one algorithm with the governor choosing a P-state for every job when
+// it arrives (ondemand looks at the utilisation of the last window); the job
+// runs entirely in that state and its burst stretches to ceil(bt / speed).
+// Idle gaps walk down the sleep states by entry latency. Energy is counted
+// from the first arrival to the last completion.
+EnergyReport simulate_energy(const std::vector<Proc>& procs, AlgoId algo, int quantum, Governor governor,
+                             const EnergyModel& model);
+
+const char* governor_name(Governor governor);
+
+// Menu entry: every algorithm under every governor
+void run_energy_report();
+
+#endif // ENERGY_MODEL_HPP
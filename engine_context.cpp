@@ -0,0 +1,79 @@
+#include "engine_context.hpp"
+#include "scheduler_common.hpp"
+#include "arrival_order.hpp"
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+
+ScratchArena::ScratchArena(std::size_t initial_bytes)
+    : offset_(0), capacity_(0), heap_allocations_(0) {
+    blocks_.reserve(8);
+    add_block(initial_bytes);
+}
+
+ScratchArena::~ScratchArena() {
+    for (const auto& b : blocks_) std::free(b.data);
+}
+
+void ScratchArena::add_block(std::size_t min_bytes) {
+    std::size_t size = blocks_.empty() ? 0 : blocks_.back().size * 2;
+    if (size < min_bytes) size = min_bytes;
+    if (size < 4096) size = 4096;
+
+    Block b;
+    b.data = static_cast<char*>(std::malloc(size));
+    if (!b.data) throw std::bad_alloc();
+    b.size = size;
+    blocks_.push_back(b);
+    offset_ = 0;
+    capacity_ += size;
+    heap_allocations_++;
+}
+
+void* ScratchArena::allocate(std::size_t bytes, std::size_t align) {
+    Block& cur = blocks_.back();
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(cur.data);
+    std::size_t aligned = ((base + offset_ + align - 1) & ~(std::uintptr_t)(align - 1)) - base;
+
+    if (aligned + bytes > cur.size) {
+        add_block(bytes + align);
+        return allocate(bytes, align);
+    }
+    offset_ = aligned + bytes;
+    return cur.data + aligned;
+}
+
+void ScratchArena::reset() {
+    if (blocks_.size() > 1) {
+        // Last run spilled over: fold everything into one block big enough for it
+        std::size_t total = capacity_;
+        for (const auto& b : blocks_) std::free(b.data);
+        blocks_.clear();
+        capacity_ = 0;
+        add_block(total);
+    }
+    offset_ = 0;
+}
+
+// Sized for the preemptive engines' per-process records (smaller than a
+// Proc); the extra ints per process cover the RR ring buffer and flag arrays.
+EngineContext::EngineContext(std::size_t expected_procs)
+    : arena_(expected_procs * (sizeof(Proc) + 2 * sizeof(int)) + 1024),
+      order_procs_(nullptr), order_size_(0) {}
+
+void EngineContext::share_arrival_order(const std::vector<Proc>& procs) {
+    order_ = arrival_order(procs);
+    order_procs_ = procs.data();
+    order_size_ = procs.size();
+}
+
+void EngineContext::forget_arrival_order() {
+    std::vector<int>().swap(order_);
+    order_procs_ = nullptr;
+    order_size_ = 0;
+}
+
+const int* EngineContext::shared_arrival_order(const std::vector<Proc>& procs) const {
+    if (procs.empty() || procs.data() != order_procs_ || procs.size() != order_size_) return nullptr;
+    return order_.data();
+}
@@ -0,0 +1,83 @@
+#ifndef ENGINE_CONTEXT_HPP
+#define ENGINE_CONTEXT_HPP
+
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+struct Proc;
+
+// Bump allocator for per-run scratch memory. Allocation is a pointer bump;
+// reset() releases everything at once but keeps the memory for the next run.
+// If a run outgrew the first block, reset() merges the blocks into one, so a
+// steady stream of similar runs stops touching the heap after the first one.
+class ScratchArena {
+public:
+    explicit ScratchArena(std::size_t initial_bytes = 64 * 1024);
+    ~ScratchArena();
+
+    void* allocate(std::size_t bytes, std::size_t align);
+
+    // Uninitialized array of trivially destructible T, valid until reset()
+    template <typename T>
+    T* alloc_array(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "ScratchArena never runs destructors");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void reset();
+
+    std::size_t capacity() const { return capacity_; }
+    std::size_t heap_allocations() const { return heap_allocations_; }
+
+private:
+    struct Block {
+        char* data;
+        std::size_t size;
+    };
+
+    void add_block(std::size_t min_bytes);
+
+    std::vector<Block> blocks_;
+    std::size_t offset_;          // Bump offset inside blocks_.back()
+    std::size_t capacity_;
+    std::size_t heap_allocations_;
+
+    ScratchArena(const ScratchArena&);
+    ScratchArena& operator=(const ScratchArena&);
+};
+
+// Scratch state shared by the fast calculate_* engines. One context can be
+// reused across any number of runs (sweeps, Monte-Carlo replications); each
+// engine resets it on entry, so nothing survives from one run to the next.
+class EngineContext {
+public:
+    // Pre-sizes the arena for workloads of up to expected_procs processes
+    explicit EngineContext(std::size_t expected_procs = 0);
+
+    // Called by every engine before it carves out its scratch buffers
+    ScratchArena& begin_run() {
+        arena_.reset();
+        return arena_;
+    }
+
+    std::size_t heap_allocations() const { return arena_.heap_allocations(); }
+
+    // Computes the arrival order of procs once (see arrival_order.hpp) so
+    // that every engine run on this same vector reuses it. The caller must
+    // not modify procs while it is shared.
+    void share_arrival_order(const std::vector<Proc>& procs);
+    void forget_arrival_order();
+
+    // The shared order when it was computed for procs, else null
+    const int* shared_arrival_order(const std::vector<Proc>& procs) const;
+
+private:
+    ScratchArena arena_;
+    std::vector<int> order_;
+    const Proc* order_procs_;     // Identity of the vector order_ belongs to
+    std::size_t order_size_;
+};
+
+#endif // ENGINE_CONTEXT_HPP
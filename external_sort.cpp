@@ -0,0 +1,424 @@
+#include "external_sort.hpp"
+#include "workload_io.hpp"
+#include "arrival_order.hpp"
+#include "fused_compare.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#ifdef _WIN32
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+#ifdef __linux__
+    #include <fcntl.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const size_t MIN_MEMORY = 1 << 20;
+const size_t MIN_BLOCK = 64 * 1024;
+const size_t MAX_BLOCK = 8 << 20;
+
+// One process in a run file
+struct RunRecord {
+    int at;
+    int bt;
+    int priority;
+    int job_class;
+    int working_set;
+    int idx;        // Position in the trace: the tie-breaker, and Proc::no - 1
+};
+
+bool record_before(const RunRecord& a, const RunRecord& b) {
+    return a.at != b.at ? a.at < b.at : a.idx < b.idx;
+}
+
+size_t block_size(const ExternalSortOptions& options) {
+    size_t b = options.block_bytes ? options.block_bytes : options.memory_bytes / 16;
+    b = min(max(b, MIN_BLOCK), MAX_BLOCK);
+    // Two input blocks and an output block always fit the budget
+    b = min(b, options.memory_bytes / 3);
+    return b / sizeof(RunRecord) * sizeof(RunRecord);
+}
+
+string new_run_path(const string& dir) {
+    static atomic<unsigned> seq(0);
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = (int)getpid();
+#endif
+    return (dir.empty() ? string(".") : dir) + "/sched_run_" + to_string(pid) + "_" +
+           to_string(seq++) + ".bin";
+}
+
+Proc to_proc(const RunRecord& r) {
+    Proc p;
+    p.no = r.idx + 1;
+    p.at = r.at;
+    p.bt = r.bt;
+    p.priority = r.priority;
+    p.job_class = r.job_class;
+    p.working_set = r.working_set;
+    p.ct = 0;
+    p.tat = 0;
+    p.wt = 0;
+    p.progress = 0;
+    p.is_completed = false;
+    return p;
+}
+
+// Reads a run one block at a time. After each block the next one is
+// announced to the OS, so the disk reads ahead while this one is merged.
+class RunReader {
+public:
+    RunReader() : f_(0), pos_(0), len_(0), offset_(0), failed_(false) {}
+    ~RunReader() {
+        if (f_) fclose(f_);
+    }
+
+    bool open(const string& path, size_t block_records) {
+        f_ = fopen(path.c_str(), "rb");
+        if (!f_) return false;
+        setvbuf(f_, 0, _IONBF, 0);   // Whole blocks are read straight into buf_
+        buf_.resize(block_records);
+#ifdef __linux__
+        posix_fadvise(fileno(f_), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        return true;
+    }
+
+    // False at the end of the run or on a read error (see failed())
+    bool next(RunRecord& r) {
+        if (pos_ == len_ && !refill()) return false;
+        r = buf_[pos_++];
+        return true;
+    }
+
+    bool failed() const { return failed_; }
+
+private:
+    bool refill() {
+        len_ = fread(&buf_[0], sizeof(RunRecord), buf_.size(), f_);
+        pos_ = 0;
+        if (len_ == 0) {
+            failed_ = ferror(f_) != 0;
+            return false;
+        }
+        offset_ += (long long)(len_ * sizeof(RunRecord));
+#ifdef __linux__
+        posix_fadvise(fileno(f_), (off_t)offset_, (off_t)(buf_.size() * sizeof(RunRecord)), POSIX_FADV_WILLNEED);
+#endif
+        return true;
+    }
+
+    FILE* f_;
+    vector<RunRecord> buf_;
+    size_t pos_, len_;
+    long long offset_;
+    bool failed_;
+
+    RunReader(const RunReader&);
+    RunReader& operator=(const RunReader&);
+};
+
+// Writes a run in whole blocks
+class RunWriter {
+public:
+    RunWriter() : f_(0), len_(0), bytes_(0), ok_(true) {}
+    ~RunWriter() {
+        if (f_) fclose(f_);
+    }
+
+    bool open(const string& path, size_t block_records) {
+        f_ = fopen(path.c_str(), "wb");
+        if (!f_) return false;
+        setvbuf(f_, 0, _IONBF, 0);
+        buf_.resize(block_records);
+        return true;
+    }
+
+    void put(const RunRecord& r) {
+        buf_[len_++] = r;
+        if (len_ == buf_.size()) flush();
+    }
+
+    // False if any write failed
+    bool close() {
+        flush();
+        if (fclose(f_) != 0) ok_ = false;
+        f_ = 0;
+        return ok_;
+    }
+
+    long long bytes() const { return bytes_; }
+
+private:
+    void flush() {
+        if (len_ && fwrite(&buf_[0], sizeof(RunRecord), len_, f_) != len_) ok_ = false;
+        bytes_ += (long long)(len_ * sizeof(RunRecord));
+        len_ = 0;
+    }
+
+    FILE* f_;
+    vector<RunRecord> buf_;
+    size_t len_;
+    long long bytes_;
+    bool ok_;
+
+    RunWriter(const RunWriter&);
+    RunWriter& operator=(const RunWriter&);
+};
+
+} // namespace
+
+// --- K-WAY MERGE ---
+// Min-heap of each run's next record
+struct ExternalArrivalSort::Merger {
+    struct Head {
+        RunRecord r;
+        size_t run;
+    };
+
+    vector<unique_ptr<RunReader>> readers;
+    vector<Head> heap;
+
+    static bool later(const Head& a, const Head& b) { return record_before(b.r, a.r); }
+
+    bool open(const vector<string>& runs, size_t block_records, string& error) {
+        for (size_t i = 0; i < runs.size(); ++i) {
+            readers.push_back(unique_ptr<RunReader>(new RunReader()));
+            if (!readers[i]->open(runs[i], block_records)) {
+                error = "cannot open run file " + runs[i];
+                return false;
+            }
+            Head h;
+            h.run = i;
+            if (readers[i]->next(h.r)) heap.push_back(h);
+            else if (readers[i]->failed()) return read_error(runs[i], error);
+        }
+        make_heap(heap.begin(), heap.end(), later);
+        return true;
+    }
+
+    // False when every run is used up, or on a read error (error is set then)
+    bool next(RunRecord& r, const vector<string>& runs, string& error) {
+        if (heap.empty()) return false;
+        pop_heap(heap.begin(), heap.end(), later);
+        Head& h = heap.back();
+        r = h.r;
+        if (readers[h.run]->next(h.r)) {
+            push_heap(heap.begin(), heap.end(), later);
+        } else {
+            size_t run = h.run;
+            heap.pop_back();
+            if (readers[run]->failed()) return read_error(runs[run], error);
+        }
+        return true;
+    }
+
+    static bool read_error(const string& path, string& error) {
+        error = "read error in run file " + path;
+        return false;
+    }
+};
+
+ExternalArrivalSort::ExternalArrivalSort() : stats_() {}
+
+ExternalArrivalSort::~ExternalArrivalSort() {
+    remove_runs();
+}
+
+void ExternalArrivalSort::remove_runs() {
+    merger_.reset();
+    for (size_t i = 0; i < runs_.size(); ++i) remove(runs_[i].c_str());
+    runs_.clear();
+}
+
+bool ExternalArrivalSort::sort(const string& path, const ExternalSortOptions& options, string& error) {
+    remove_runs();
+    stats_ = ExternalSortStats();
+    if (options.memory_bytes < MIN_MEMORY) {
+        error = "memory budget must be at least 1 MiB";
+        return false;
+    }
+    size_t block = block_size(options);
+    size_t block_records = block / sizeof(RunRecord);
+
+    // 1. Runs: chunks of the trace sorted in memory. Per process: the record,
+    //    its slot in the permutation and the radix sort's temporaries.
+    WorkloadReader reader;
+    if (!reader.open(path, error, block)) return false;
+    size_t per_proc = sizeof(Proc) + 4 * sizeof(int);
+    size_t chunk_cap = max((size_t)1, (options.memory_bytes - 2 * block) / per_proc);
+    vector<Proc> chunk;
+    vector<int> order;
+    chunk.reserve(chunk_cap);
+    order.resize(chunk_cap);
+
+    Proc p;
+    bool more = true;
+    while (more) {
+        chunk.clear();
+        while (chunk.size() < chunk_cap && (more = reader.next(p, error))) chunk.push_back(p);
+        if (!error.empty()) return false;
+        if (reader.count() > numeric_limits<int>::max()) {
+            error = path + ": more than " + to_string(numeric_limits<int>::max()) + " processes";
+            return false;
+        }
+        if (chunk.empty()) break;
+
+        int n = (int)chunk.size();
+        int first = (int)(reader.count() - n);
+        arrival_order(chunk.data(), n, order.data());
+        runs_.push_back(new_run_path(options.temp_dir));
+        RunWriter w;
+        if (!w.open(runs_.back(), block_records)) {
+            error = "cannot create run file " + runs_.back();
+            return false;
+        }
+        for (int k = 0; k < n; ++k) {
+            const Proc& q = chunk[order[k]];
+            RunRecord r = {q.at, q.bt, q.priority, q.job_class, q.working_set, first + order[k]};
+            w.put(r);
+        }
+        if (!w.close()) {
+            error = "cannot write run file " + runs_.back() + " (disk full?)";
+            return false;
+        }
+        stats_.bytes_spilled += w.bytes();
+    }
+    vector<Proc>().swap(chunk);
+    vector<int>().swap(order);
+    stats_.processes = reader.count();
+    stats_.runs = (long long)runs_.size();
+    if (runs_.empty()) {
+        error = path + ": no processes";
+        return false;
+    }
+
+    // 2. Merge passes until one merge can read every run at once
+    size_t fan_in = max((size_t)2, options.memory_bytes / block - 1);
+    while (runs_.size() > fan_in) {
+        vector<string> merged;
+        size_t i = 0;
+        bool ok = true;
+        for (; ok && i < runs_.size(); i += fan_in) {
+            vector<string> group(runs_.begin() + i, runs_.begin() + min(runs_.size(), i + fan_in));
+            if (group.size() == 1) {
+                merged.push_back(group[0]);
+                continue;
+            }
+            merged.push_back(new_run_path(options.temp_dir));
+            Merger m;
+            RunWriter w;
+            if (!m.open(group, block_records, error)) {
+                ok = false;
+            } else if (!w.open(merged.back(), block_records)) {
+                error = "cannot create run file " + merged.back();
+                ok = false;
+            } else {
+                RunRecord r;
+                while (m.next(r, group, error)) w.put(r);
+                if (!error.empty()) ok = false;
+                if (!w.close() && ok) {
+                    error = "cannot write run file " + merged.back() + " (disk full?)";
+                    ok = false;
+                }
+                stats_.bytes_spilled += w.bytes();
+            }
+            if (ok) {
+                for (size_t g = 0; g < group.size(); ++g) remove(group[g].c_str());
+            } else {
+                merged.insert(merged.end(), group.begin(), group.end());   // Left for remove_runs()
+            }
+        }
+        if (!ok) merged.insert(merged.end(), runs_.begin() + min(runs_.size(), i), runs_.end());
+        runs_.swap(merged);
+        if (!ok) return false;
+        stats_.merge_passes++;
+    }
+
+    // 3. The last merge is streamed by next()
+    merger_.reset(new Merger());
+    return merger_->open(runs_, block_records, error);
+}
+
+bool ExternalArrivalSort::next(Proc& p, int& idx, string& error) {
+    error.clear();
+    RunRecord r;
+    if (!merger_ || !merger_->next(r, runs_, error)) return false;
+    p = to_proc(r);
+    idx = r.idx;
+    return true;
+}
+
+bool compare_workload_external(const string& path, int quantum, const ExternalSortOptions& options,
+                               vector<AlgoResult>& results, string& error, ExternalSortStats* stats) {
+    ExternalArrivalSort sorted;
+    if (!sorted.sort(path, options, error)) return false;
+
+    FusedComparison fused(quantum);
+    Proc p;
+    int idx;
+    while (sorted.next(p, idx, error)) fused.feed(p, idx);
+    if (!error.empty()) return false;
+    fused.finish();
+    results = fused.results();
+    if (stats) *stats = sorted.stats();
+    return true;
+}
+
+// --- MENU ENTRY ---
+void run_out_of_core_comparison() {
+    cout << "\n<-- Out-of-Core Comparison of a Trace Larger than RAM Selected -->" << endl;
+    ExternalSortOptions options;
+    string path;
+    cout << "Workload file, in any order (AT BT [PRIORITY] per line): ";
+    cin >> path;
+    cout << "Directory for temporary sorted runs (. for the current one): ";
+    cin >> options.temp_dir;
+
+    long long mib;
+    cout << "Memory budget for sorting, in MiB (e.g. 1024): ";
+    if (!(cin >> mib) || mib < 1) {
+        cout << "Invalid budget. Using 256 MiB." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        mib = 256;
+    }
+    options.memory_bytes = (size_t)mib << 20;
+    options.block_bytes = 0;
+
+    int quantum;
+    cout << "Enter Time Quantum (Q) for Round Robin: ";
+    if (!(cin >> quantum) || quantum <= 0) {
+        cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        quantum = 2;
+    }
+
+    cout << "\nSorting by arrival time and comparing..." << endl;
+    vector<AlgoResult> results;
+    ExternalSortStats stats;
+    string error;
+    if (compare_workload_external(path, quantum, options, results, error, &stats)) {
+        clearScreen();
+        print_comparison_table(results);
+        cout << stats.processes << " processes sorted in " << stats.runs << " run(s) and "
+             << stats.merge_passes << " extra merge pass(es); " << fixed << setprecision(1)
+             << stats.bytes_spilled / 1048576.0 << " MiB written to " << options.temp_dir << "." << endl;
+    } else {
+        cout << "\nComparison failed: " << error << endl;
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
@@ -0,0 +1,66 @@
+#ifndef EXTERNAL_SORT_HPP
+#define EXTERNAL_SORT_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "comparison_tool.hpp"
+
+struct ExternalSortOptions {
+    std::string temp_dir;       // Sorted runs are written here
+    std::size_t memory_bytes;   // Buffer budget for sorting and merging (>= 1 MiB)
+    std::size_t block_bytes;    // Unit of sequential reads and writes; 0 picks one from memory_bytes
+};
+
+struct ExternalSortStats {
+    long long processes;
+    long long runs;             // Sorted runs cut from the trace
+    int merge_passes;           // Intermediate merges needed before the final streamed one
+    long long bytes_spilled;    // Run data written to temp_dir, over all passes
+};
+
+// Arrival-ordered stream of a workload file of any size (external merge sort).
+// The trace is cut into runs that fit memory_bytes, each sorted in memory and
+// written to temp_dir; runs are then merged with at most as many input blocks
+// as the budget holds, in extra passes if there are more runs than that.
+// next() serves the last merge directly, so the sorted trace is never written
+// out whole. Memory use depends on the budget, not on the trace size. Run
+// files are removed by the destructor.
+class ExternalArrivalSort {
+public:
+    ExternalArrivalSort();
+    ~ExternalArrivalSort();
+
+    bool sort(const std::string& path, const ExternalSortOptions& options, std::string& error);
+
+    // Next process in (at, index) order; idx is its 0-based position in the
+    // file. False at the end or on a read error (error is set then).
+    bool next(Proc& p, int& idx, std::string& error);
+
+    const ExternalSortStats& stats() const { return stats_; }
+
+private:
+    struct Merger;
+
+    void remove_runs();
+
+    std::vector<std::string> runs_;
+    std::unique_ptr<Merger> merger_;
+    ExternalSortStats stats_;
+
+    ExternalArrivalSort(const ExternalArrivalSort&);
+    ExternalArrivalSort& operator=(const ExternalArrivalSort&);
+};
+
+// All five comparison algorithms over the sorted stream of a workload file
+// that need not fit in memory. Only the engines' ready sets grow with the
+// trace (by how many jobs wait at once, not by its length).
+bool compare_workload_external(const std::string& path, int quantum, const ExternalSortOptions& options,
+                               std::vector<AlgoResult>& results, std::string& error,
+                               ExternalSortStats* stats = 0);
+
+// Menu entry
+void run_out_of_core_comparison();
+
+#endif // EXTERNAL_SORT_HPP
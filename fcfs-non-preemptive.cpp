@@ -1,9 +1,13 @@
 #include "scheduler_common.hpp"
+#include "perf_counters.hpp"
+#include "sim_viewport.hpp"
+#include "live_view.hpp"
 #include <algorithm>
 #include <thread>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <memory>
 
 using namespace std;
 
@@ -48,6 +52,27 @@ void printSimulation_fcfs(const vector<Proc>& processes, int n, int current_time
     }
 }
 
+// One frame: the full listing for small workloads, the viewport otherwise.
+// processes are in run order and running is the index of the current job,
+// or of the next one to run while the CPU is idle.
+static void show_frame_fcfs(SimViewport& view, const vector<Proc>& processes, int n, int current_time, int running, bool idle) {
+    if (!view.active()) {
+        printSimulation_fcfs(processes, n, current_time);
+        return;
+    }
+    const int total_bar_length = 50;
+    view.set_time(current_time);
+    view.set_running(idle ? -1 : processes[running].no);
+    if (!idle) view.set_progress(processes[running].no, processes[running].progress * 100 / total_bar_length);
+    // Arrived jobs queue in run order, so the panel is the next few indices
+    view.clear_ready();
+    int first = idle ? running : running + 1;
+    for (int j = first; j < n && j < first + view.rows() && processes[j].at <= current_time; ++j) {
+        view.offer_ready(processes[j].no, j);
+    }
+    view.render("FCFS Scheduling Simulation");
+}
+
 void run_fcfs_non_preemptive_simulation() {
     int n;
     cout << "\n<--FCFS Scheduling Algorithm Simulation Selected-->" << endl;
@@ -63,8 +88,10 @@ void run_fcfs_non_preemptive_simulation() {
     for (int i = 0; i < n; ++i) {
         p.push_back(read_proc(i + 1));
     }
+    if (run_visual_mode_live(p, ALGO_FCFS, 0)) return;
     
     sort(p.begin(), p.end(), compareByAT);
+    SimViewport view(p);
 
     cout << "\nProcesses sorted by Arrival Time. Simulation starting in 2 seconds...\n";
     this_thread::sleep_for(chrono::seconds(2));
@@ -74,14 +101,22 @@ void run_fcfs_non_preemptive_simulation() {
     float avgwt = 0.0f;
     const int total_bar_length = 50; 
     const int time_slice_ms = 20; 
+
+    // Optional hardware counters (SIM_PERF=1); frames and pacing sleeps are excluded
+    unique_ptr<PerfCounters> counters;
+    if (perf_profiling_enabled()) {
+        counters.reset(new PerfCounters());
+        counters->start();
+    }
     
     for (int i = 0; i < n; ++i) {
         
         if (current_time < p[i].at) {
+            PerfPause render(counters.get());
             int idle_start = current_time;
             
             while (current_time < p[i].at) {
-                 printSimulation_fcfs(p, n, current_time);
+                 show_frame_fcfs(view, p, n, current_time, i, true);
                  current_time++; 
                  this_thread::sleep_for(chrono::seconds(1));
             }
@@ -95,13 +130,14 @@ void run_fcfs_non_preemptive_simulation() {
         
         long long ms_per_hash = total_duration_ms / total_bar_length;
 
+        if (counters) counters->pause(); // The progress animation is all rendering
         while (p[i].progress < total_bar_length) {
             
             if (elapsed_ms >= ms_per_hash * (p[i].progress + 1)) {
                 p[i].progress++;
             }
             
-            printSimulation_fcfs(p, n, current_time);
+            show_frame_fcfs(view, p, n, current_time, i, false);
             
             this_thread::sleep_for(chrono::milliseconds(time_slice_ms));
             elapsed_ms += time_slice_ms;
@@ -110,22 +146,28 @@ void run_fcfs_non_preemptive_simulation() {
                  current_time = start_time + (elapsed_ms / 1000);
             }
         }
+        if (counters) counters->resume();
 
         p[i].ct = start_time + p[i].bt;
         current_time = p[i].ct; 
+        view.complete(p[i].no, p[i].ct);
 
         p[i].tat = p[i].ct - p[i].at;
         avgtat += p[i].tat;
         p[i].wt = p[i].tat - p[i].bt;
         avgwt += p[i].wt;
         
-        printSimulation_fcfs(p, n, current_time);
+        if (counters) counters->pause();
+        show_frame_fcfs(view, p, n, current_time, i + 1, true);
         cout << "\nProcess P" << p[i].no << " Completed at T=" << p[i].ct << ".\n";
         this_thread::sleep_for(chrono::seconds(1)); 
+        if (counters) counters->resume();
     }
 
     avgtat /= n;
     avgwt /= n;
+    PerfSample perf_sample = PerfSample();
+    if (counters) perf_sample = counters->stop();
 
     clearScreen();
     cout << "\n=== FCFS Non-Preemptive Simulation Complete ===" << endl;
@@ -144,6 +186,11 @@ void run_fcfs_non_preemptive_simulation() {
     cout << std::fixed << std::setprecision(2);
     cout << "\n\033[1;35mAverage Turnaround Time =\033[0m " << avgtat << " seconds" << endl;
     cout << "\033[1;35mAverage Waiting Time =\033[0m " << avgwt << " seconds" << endl;
+
+    if (counters) {
+        print_perf_table(vector<string>(1, "FCFS"), vector<PerfSample>(1, perf_sample),
+                         counters->unavailable_reason());
+    }
     
     // Wait for user before returning to the main menu
     cin.ignore();
@@ -0,0 +1,96 @@
+#include "fused_compare.hpp"
+#include "workload_io.hpp"
+#include "arrival_order.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+FusedComparison::FusedComparison(int quantum) : fed_(0) {
+    for (int a = 0; a < ALGO_COUNT; ++a) engines_[a] = StreamEngine((AlgoId)a, quantum);
+}
+
+void FusedComparison::feed(const Proc& p, int idx) {
+    for (int a = 0; a < ALGO_COUNT; ++a) engines_[a].feed(p, idx);
+    fed_++;
+}
+
+void FusedComparison::finish() {
+    for (int a = 0; a < ALGO_COUNT; ++a) engines_[a].finish();
+}
+
+vector<AlgoResult> FusedComparison::results() const {
+    vector<AlgoResult> results;
+    for (int a = 0; a < ALGO_COUNT; ++a) results.push_back(engines_[a].result(fed_));
+    return results;
+}
+
+vector<AlgoResult> compare_fused(const vector<Proc>& procs, int quantum) {
+    vector<int> order = arrival_order(procs);
+
+    FusedComparison fused(quantum);
+    for (size_t i = 0; i < order.size(); ++i) fused.feed(procs[order[i]], order[i]);
+    fused.finish();
+    return fused.results();
+}
+
+bool compare_workload_stream(const string& path, int quantum, vector<AlgoResult>& results,
+                             string& error, long long* processes) {
+    WorkloadReader reader;
+    if (!reader.open(path, error)) return false;
+
+    FusedComparison fused(quantum);
+    Proc p;
+    int last_at = 0;
+    while (reader.next(p, error)) {
+        if (p.at < last_at) {
+            error = path + ":" + to_string(reader.line()) +
+                    ": arrival times must not decrease for a single-pass comparison";
+            return false;
+        }
+        last_at = p.at;
+        // File order is (at, index) order here, so the line's index is the tie-breaker
+        fused.feed(p, (int)(reader.count() - 1));
+    }
+    if (!error.empty()) return false;
+    if (fused.fed() == 0) {
+        error = path + ": no processes";
+        return false;
+    }
+    fused.finish();
+    results = fused.results();
+    if (processes) *processes = fused.fed();
+    return true;
+}
+
+// --- MENU ENTRY ---
+void run_streamed_comparison() {
+    cout << "\n<-- Single-Pass Comparison of a Streamed Trace Selected -->" << endl;
+    string path;
+    cout << "Workload file, sorted by arrival time (AT BT [PRIORITY] per line): ";
+    cin >> path;
+
+    int quantum;
+    cout << "Enter Time Quantum (Q) for Round Robin: ";
+    if (!(cin >> quantum) || quantum <= 0) {
+        cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        quantum = 2;
+    }
+
+    vector<AlgoResult> results;
+    string error;
+    long long processes = 0;
+    if (compare_workload_stream(path, quantum, results, error, &processes)) {
+        clearScreen();
+        print_comparison_table(results);
+        cout << processes << " processes read in one pass." << endl;
+    } else {
+        cout << "\nComparison failed: " << error << endl;
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
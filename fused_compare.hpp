@@ -0,0 +1,43 @@
+#ifndef FUSED_COMPARE_HPP
+#define FUSED_COMPARE_HPP
+
+#include <string>
+#include <vector>
+#include "comparison_tool.hpp"
+#include "stream_engine.hpp"
+
+// All five comparison algorithms driven from one arrival stream: every
+// arrival is handed to each algorithm's StreamEngine, which advances its own
+// event loop up to that arrival. Only the engines' ready queues are kept, not
+// the trace. Results match calculate_* (FCFS breaks equal arrival times by
+// input order).
+class FusedComparison {
+public:
+    explicit FusedComparison(int quantum);
+
+    // Arrivals must come in (at, idx) order
+    void feed(const Proc& p, int idx);
+    void finish();
+
+    // In run_all_algorithms_comparison order
+    std::vector<AlgoResult> results() const;
+
+    long long fed() const { return fed_; }
+
+private:
+    StreamEngine engines_[ALGO_COUNT];
+    long long fed_;
+};
+
+// One pass over an in-memory workload (sorted once by arrival time)
+std::vector<AlgoResult> compare_fused(const std::vector<Proc>& procs, int quantum);
+
+// One pass over a workload file, reading each line once and keeping none of
+// them. The file must list processes in non-decreasing arrival time.
+bool compare_workload_stream(const std::string& path, int quantum, std::vector<AlgoResult>& results,
+                             std::string& error, long long* processes = 0);
+
+// Menu entry
+void run_streamed_comparison();
+
+#endif // FUSED_COMPARE_HPP
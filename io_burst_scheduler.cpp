@@ -0,0 +1,342 @@
+#include "io_burst_scheduler.hpp"
+#include <iostream>
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <queue>
+#include <deque>
+
+using namespace std;
+
+namespace {
+
+const long long NO_EVENT = numeric_limits<long long>::max();
+
+// Ready queue entry: smaller key runs first, seq keeps ties in FCFS order
+struct IOReadyEntry {
+    long long key;
+    long long seq;
+    int idx;
+};
+
+struct IOReadyOrder {
+    bool operator()(const IOReadyEntry& a, const IOReadyEntry& b) const {
+        if (a.key != b.key) return a.key > b.key;
+        return a.seq > b.seq;
+    }
+};
+
+// Per-job runtime state
+struct IOJobState {
+    int burst;             // Index of the current CPU burst
+    long long remaining;   // Remaining time of the current CPU burst
+    long long ready_since; // When the job last entered the ready queue
+    long long wt;          // Accumulated ready-queue waiting time
+    long long ct;
+};
+
+struct IODevice {
+    int job = -1;            // Job currently served, -1 when idle
+    long long finish = 0;    // Completion time of the current I/O burst
+    long long busy = 0;      // Total busy time
+    deque<int> waiting;      // FCFS device queue
+};
+
+string policy_name(IOSchedPolicy policy, int quantum) {
+    switch (policy) {
+        case IO_FCFS:        return "FCFS";
+        case IO_SJF_NP:      return "SJF (NP)";
+        case IO_PRIORITY_NP: return "Priority (NP)";
+        case IO_SRTF:        return "SRTF (P)";
+        case IO_RR:          return "RR (Q=" + to_string(quantum) + ")";
+    }
+    return "?";
+}
+
+} // namespace
+
+// --- EVENT-DRIVEN CPU/I-O SCHEDULER ---
+// Events are arrivals, CPU burst end / quantum expiry and I/O completions.
+// At each event time: I/O completions re-enter the ready queue first, then
+// new arrivals, then the job leaving the CPU (so RR keeps the same ordering
+// as calculate_rr), and finally the CPU is (re)dispatched.
+IOAlgoResult calculate_io_schedule(const vector<IOBurstProc>& procs, IOSchedPolicy policy,
+                                   int quantum, int num_devices) {
+    IOAlgoResult result;
+    result.algo_name = policy_name(policy, quantum);
+    result.avg_tat = 0.0;
+    result.avg_wt = 0.0;
+    result.cpu_util = 0.0;
+    result.device_util.assign(num_devices > 0 ? num_devices : 0, 0.0);
+    if (procs.empty() || num_devices <= 0 || (policy == IO_RR && quantum <= 0)) return result;
+
+    int n = procs.size();
+    vector<int> order(n);
+    for (int i = 0; i < n; ++i) order[i] = i;
+    stable_sort(order.begin(), order.end(),
+                [&](int a, int b) { return procs[a].at < procs[b].at; });
+
+    vector<IOJobState> jobs(n);
+    for (int i = 0; i < n; ++i) {
+        jobs[i].burst = 0;
+        jobs[i].remaining = procs[i].cpu_bursts.empty() ? 0 : procs[i].cpu_bursts[0];
+        jobs[i].ready_since = 0;
+        jobs[i].wt = 0;
+        jobs[i].ct = 0;
+    }
+
+    vector<IODevice> devices(num_devices);
+    priority_queue<IOReadyEntry, vector<IOReadyEntry>, IOReadyOrder> ready;
+    long long seq = 0;
+
+    auto ready_key = [&](int i) -> long long {
+        switch (policy) {
+            case IO_SJF_NP:
+            case IO_SRTF:        return jobs[i].remaining;
+            case IO_PRIORITY_NP: return procs[i].priority;
+            default:             return 0;
+        }
+    };
+    auto make_ready = [&](int i, long long now) {
+        jobs[i].ready_since = now;
+        IOReadyEntry e;
+        e.key = ready_key(i);
+        e.seq = seq++;
+        e.idx = i;
+        ready.push(e);
+    };
+    auto start_io = [&](int d, int i, long long now) {
+        devices[d].job = i;
+        devices[d].finish = now + procs[i].io_bursts[jobs[i].burst - 1];
+    };
+
+    long long current_time = procs[order[0]].at;
+    long long first_arrival = current_time;
+    long long cpu_busy = 0;
+    int next_arrival = 0;
+    int completed_count = 0;
+    int running = -1;
+    long long run_start = 0;   // Start of the current CPU segment
+    long long slice_used = 0;  // CPU time used in the current RR quantum
+    double total_tat = 0;
+    double total_wt = 0;
+
+    while (completed_count < n) {
+        // 1. Find the next event
+        long long next_time = NO_EVENT;
+        if (next_arrival < n) next_time = procs[order[next_arrival]].at;
+        if (running != -1) {
+            long long left = jobs[running].remaining;
+            if (policy == IO_RR) left = min(left, (long long)quantum - slice_used);
+            next_time = min(next_time, run_start + left);
+        }
+        for (const auto& dev : devices) {
+            if (dev.job != -1) next_time = min(next_time, dev.finish);
+        }
+        if (next_time == NO_EVENT) break;
+
+        // 2. Advance the clock
+        if (running != -1) {
+            long long ran = next_time - run_start;
+            jobs[running].remaining -= ran;
+            slice_used += ran;
+            cpu_busy += ran;
+            run_start = next_time;
+        }
+        current_time = next_time;
+
+        // 3. I/O completions
+        for (int d = 0; d < num_devices; ++d) {
+            IODevice& dev = devices[d];
+            if (dev.job == -1 || dev.finish != current_time) continue;
+            int i = dev.job;
+            dev.busy += procs[i].io_bursts[jobs[i].burst - 1];
+            jobs[i].remaining = procs[i].cpu_bursts[jobs[i].burst];
+            make_ready(i, current_time);
+            dev.job = -1;
+            if (!dev.waiting.empty()) {
+                int nxt = dev.waiting.front();
+                dev.waiting.pop_front();
+                start_io(d, nxt, current_time);
+            }
+        }
+
+        // 4. Arrivals
+        while (next_arrival < n && procs[order[next_arrival]].at == current_time) {
+            make_ready(order[next_arrival], current_time);
+            next_arrival++;
+        }
+
+        // 5. CPU burst end or quantum expiry
+        if (running != -1) {
+            int i = running;
+            if (jobs[i].remaining == 0) {
+                running = -1;
+                if (jobs[i].burst + 1 >= (int)procs[i].cpu_bursts.size()) {
+                    jobs[i].ct = current_time;
+                    total_tat += jobs[i].ct - procs[i].at;
+                    total_wt += jobs[i].wt;
+                    completed_count++;
+                } else {
+                    jobs[i].burst++;
+                    int d = procs[i].io_device[jobs[i].burst - 1];
+                    if (d < 0 || d >= num_devices) d = 0;
+                    if (devices[d].job == -1) start_io(d, i, current_time);
+                    else devices[d].waiting.push_back(i);
+                }
+            } else if (policy == IO_RR && slice_used >= quantum) {
+                running = -1;
+                make_ready(i, current_time);
+            }
+        }
+
+        // 6. SRTF preemption by a shorter ready burst
+        if (policy == IO_SRTF && running != -1 && !ready.empty() &&
+            ready.top().key < jobs[running].remaining) {
+            make_ready(running, current_time);
+            running = -1;
+        }
+
+        // 7. Dispatch
+        if (running == -1 && !ready.empty()) {
+            running = ready.top().idx;
+            ready.pop();
+            jobs[running].wt += current_time - jobs[running].ready_since;
+            run_start = current_time;
+            slice_used = 0;
+        }
+    }
+
+    long long span = current_time - first_arrival;
+    result.avg_tat = total_tat / n;
+    result.avg_wt = total_wt / n;
+    if (span > 0) {
+        result.cpu_util = 100.0 * cpu_busy / span;
+        for (int d = 0; d < num_devices; ++d) {
+            result.device_util[d] = 100.0 * devices[d].busy / span;
+        }
+    }
+    return result;
+}
+
+// Input Function for an I/O workload:
+IOBurstProc read_io_burst_proc(int i, int num_devices) {
+    IOBurstProc p;
+    cout << "\nProcess No: " << i << endl;
+    p.no = i;
+    cout << "Enter Arrival Time (AT in seconds): ";
+    cin >> p.at;
+    cout << "Enter Priority (Lower number = Higher Priority): ";
+    cin >> p.priority;
+
+    int bursts;
+    cout << "Enter Number of CPU Bursts: ";
+    if (!(cin >> bursts) || bursts <= 0) {
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        bursts = 1;
+    }
+
+    for (int k = 0; k < bursts; ++k) {
+        int cpu;
+        cout << "  CPU Burst " << k + 1 << " (s): ";
+        cin >> cpu;
+        p.cpu_bursts.push_back(cpu);
+        if (k + 1 == bursts) break;
+
+        int io, dev = 1;
+        cout << "  I/O Burst " << k + 1 << " (s): ";
+        cin >> io;
+        if (num_devices > 1) {
+            cout << "  I/O Device (1-" << num_devices << "): ";
+            cin >> dev;
+        }
+        if (dev < 1 || dev > num_devices) dev = 1;
+        p.io_bursts.push_back(io);
+        p.io_device.push_back(dev - 1);
+    }
+    return p;
+}
+
+// --- Main I/O Burst Comparison Function ---
+void run_io_burst_comparison() {
+    int n;
+    cout << "\n<-- CPU/I-O Burst Comparison Selected -->" << endl;
+    cout << "Enter Number of Processes: ";
+    if (!(cin >> n) || n <= 0) {
+        cout << "Invalid number of processes." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return;
+    }
+
+    int num_devices;
+    cout << "Enter Number of I/O Devices: ";
+    if (!(cin >> num_devices) || num_devices <= 0) {
+        cout << "Invalid number of devices. Using 1 device." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        num_devices = 1;
+    }
+
+    int quantum;
+    cout << "Enter Time Quantum (Q) for Round Robin: ";
+    if (!(cin >> quantum) || quantum <= 0) {
+        cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        quantum = 2;
+    }
+
+    vector<IOBurstProc> procs;
+    for (int i = 0; i < n; ++i) {
+        procs.push_back(read_io_burst_proc(i + 1, num_devices));
+    }
+
+    vector<IOAlgoResult> results;
+    results.push_back(calculate_io_schedule(procs, IO_FCFS, quantum, num_devices));
+    results.push_back(calculate_io_schedule(procs, IO_SJF_NP, quantum, num_devices));
+    results.push_back(calculate_io_schedule(procs, IO_PRIORITY_NP, quantum, num_devices));
+    results.push_back(calculate_io_schedule(procs, IO_SRTF, quantum, num_devices));
+    results.push_back(calculate_io_schedule(procs, IO_RR, quantum, num_devices));
+
+    clearScreen();
+    cout << "\n========================================================" << endl;
+    cout << "|| CPU/I-O BURST WORKLOAD COMPARISON RESULTS ||" << endl;
+    cout << "========================================================" << endl;
+
+    cout << fixed << setprecision(2);
+
+    cout << left << setw(20) << "\n| Algorithm"
+         << right << setw(15) << "| Avg TAT (s)"
+         << right << setw(15) << "| Avg WT (s)"
+         << right << setw(10) << "| CPU %";
+    for (int d = 0; d < num_devices; ++d) {
+        cout << right << setw(8) << ("| D" + to_string(d + 1) + " %");
+    }
+    cout << " |" << endl;
+    cout << "--------------------------------------------------------" << endl;
+
+    double min_wt = numeric_limits<double>::max();
+    for (const auto& r : results) {
+        if (r.avg_wt < min_wt) min_wt = r.avg_wt;
+    }
+
+    for (const auto& res : results) {
+        bool is_best = (res.avg_wt == min_wt);
+        string format_start = is_best ? "\033[1;32m" : "";
+        string format_end = is_best ? "\033[0m" : "";
+
+        cout << format_start
+             << "| " << left << setw(18) << res.algo_name
+             << right << setw(15) << res.avg_tat
+             << right << setw(15) << res.avg_wt
+             << right << setw(10) << res.cpu_util;
+        for (double u : res.device_util) {
+            cout << right << setw(8) << u;
+        }
+        cout << " |" << format_end << endl;
+    }
+
+    cout << "--------------------------------------------------------" << endl;
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
@@ -0,0 +1,43 @@
+#ifndef IO_BURST_SCHEDULER_HPP
+#define IO_BURST_SCHEDULER_HPP
+
+#include <vector>
+#include <string>
+#include "scheduler_common.hpp"
+
+// A job made of alternating CPU and I/O bursts: CPU, I/O, CPU, ..., CPU.
+// io_bursts[k] / io_device[k] sit between cpu_bursts[k] and cpu_bursts[k + 1].
+struct IOBurstProc {
+    int no;          // Process number
+    int at;          // Arrival Time
+    int priority;    // Priority (lower number = higher priority)
+    std::vector<int> cpu_bursts;
+    std::vector<int> io_bursts;
+    std::vector<int> io_device;  // 0-based device index for each I/O burst
+};
+
+enum IOSchedPolicy {
+    IO_FCFS,
+    IO_SJF_NP,
+    IO_PRIORITY_NP,
+    IO_SRTF,
+    IO_RR
+};
+
+// Result of one algorithm over an I/O workload
+struct IOAlgoResult {
+    std::string algo_name;
+    double avg_tat;
+    double avg_wt;                   // Time spent in the CPU ready queue
+    double cpu_util;                 // % of the schedule span the CPU was busy
+    std::vector<double> device_util; // % of the schedule span each device was busy
+};
+
+// Event-driven run of one policy; devices serve their queues FCFS.
+IOAlgoResult calculate_io_schedule(const std::vector<IOBurstProc>& procs, IOSchedPolicy policy,
+                                   int quantum, int num_devices);
+
+// Menu entry: reads an I/O workload and compares all policies on it
+void run_io_burst_comparison();
+
+#endif // IO_BURST_SCHEDULER_HPP
@@ -0,0 +1,101 @@
+#include "kinetic_tournament.hpp"
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+const long long NEVER = numeric_limits<long long>::max();
+
+// Ratio comparisons multiply a time by a burst; keep them exact
+#ifdef __SIZEOF_INT128__
+typedef __int128 wide;
+#else
+typedef long long wide;
+#endif
+
+wide floor_div(wide a, wide b) {   // b > 0
+    wide q = a / b;
+    return (a % b != 0 && a < 0) ? q - 1 : q;
+}
+
+wide ceil_div(wide a, wide b) {    // b > 0
+    wide q = a / b;
+    return (a % b != 0 && a > 0) ? q + 1 : q;
+}
+
+} // namespace
+
+KineticTournament::KineticTournament(ScratchArena& arena, const int* at, const int* bt, int n)
+    : at_(at), bt_(bt), leaves_(1), now_(numeric_limits<long long>::min()) {
+    while (leaves_ < n) leaves_ *= 2;
+    win_ = arena.alloc_array<int>(2 * leaves_);
+    fail_ = arena.alloc_array<long long>(2 * leaves_);
+    fill(win_, win_ + 2 * leaves_, -1);
+    fill(fail_, fail_ + 2 * leaves_, NEVER);
+}
+
+// Higher ratio at now_, then lower slot
+bool KineticTournament::better(int a, int b) const {
+    bool a_zero = bt_[a] <= 0, b_zero = bt_[b] <= 0;
+    if (a_zero || b_zero) return a_zero && (!b_zero || a < b);
+    // (now - at_a + bt_a) / bt_a vs (now - at_b + bt_b) / bt_b
+    wide lhs = (wide)(now_ - at_[a] + bt_[a]) * bt_[b];
+    wide rhs = (wide)(now_ - at_[b] + bt_[b]) * bt_[a];
+    if (lhs != rhs) return lhs > rhs;
+    return a < b;
+}
+
+// First integer time after now_ at which `loser` ranks above `winner`
+long long KineticTournament::failure_time(int winner, int loser) const {
+    long long bw = bt_[winner], bl = bt_[loser];
+    if (bw <= 0 || bl <= 0 || bw <= bl) return NEVER;  // The loser's ratio never grows faster
+    // loser - winner, scaled by bw * bl: t * (bw - bl) + (cl * bw - cw * bl), with c = bt - at
+    wide d = bw - bl;
+    wide e = (wide)(bl - at_[loser]) * bw - (wide)(bw - at_[winner]) * bl;
+    wide t = loser < winner ? ceil_div(-e, d) : floor_div(-e, d) + 1;
+    if (t <= now_) t = now_ + 1;
+    return t >= (wide)NEVER ? NEVER : (long long)t;
+}
+
+void KineticTournament::recompute(int node) {
+    int a = win_[2 * node], b = win_[2 * node + 1];
+    long long cert = NEVER;
+    if (a < 0) {
+        win_[node] = b;
+    } else if (b < 0) {
+        win_[node] = a;
+    } else if (better(a, b)) {
+        win_[node] = a;
+        cert = failure_time(a, b);
+    } else {
+        win_[node] = b;
+        cert = failure_time(b, a);
+    }
+    fail_[node] = min(cert, min(fail_[2 * node], fail_[2 * node + 1]));
+}
+
+void KineticTournament::fix(int node) {
+    if (fail_[node] > now_ || node >= leaves_) return;
+    fix(2 * node);
+    fix(2 * node + 1);
+    recompute(node);
+}
+
+void KineticTournament::advance(long long t) {
+    now_ = t;
+    fix(1);
+}
+
+void KineticTournament::insert(int slot) {
+    int node = leaves_ + slot;
+    win_[node] = slot;
+    for (node /= 2; node >= 1; node /= 2) recompute(node);
+}
+
+void KineticTournament::remove(int slot) {
+    int node = leaves_ + slot;
+    win_[node] = -1;
+    for (node /= 2; node >= 1; node /= 2) recompute(node);
+}
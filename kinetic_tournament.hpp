@@ -0,0 +1,44 @@
+#ifndef KINETIC_TOURNAMENT_HPP
+#define KINETIC_TOURNAMENT_HPP
+
+#include "engine_context.hpp"
+
+// Ready set for Highest Response Ratio Next. A waiting job's response ratio
+// (t - at + bt) / bt is linear in t, so the job with the highest ratio only
+// changes when two of these lines cross. The structure is a tournament tree
+// over the job slots: every internal node keeps the winner of its two
+// children at the current time together with the time its certificate fails
+// (the loser overtakes), and the minimum failure time of its subtree.
+// advance() replays only the subtrees whose certificates failed, so
+// selection is O(log n) plus the crossings that actually happen.
+//
+// Slots are jobs in (at, index) order; equal ratios go to the lower slot.
+// Jobs with bt <= 0 rank above every other job. Time must not go backwards.
+class KineticTournament {
+public:
+    // at and bt must stay valid while the structure is in use; all memory
+    // comes from the arena
+    KineticTournament(ScratchArena& arena, const int* at, const int* bt, int n);
+
+    void advance(long long t);
+    void insert(int slot);   // At the current time
+    void remove(int slot);
+
+    int top() const { return win_[1]; }   // -1 when empty
+    bool empty() const { return win_[1] < 0; }
+
+private:
+    bool better(int a, int b) const;
+    long long failure_time(int winner, int loser) const;
+    void recompute(int node);
+    void fix(int node);
+
+    const int* at_;
+    const int* bt_;
+    int leaves_;          // Power of two >= number of slots
+    int* win_;            // Per node: winning slot, -1 if the subtree is empty
+    long long* fail_;     // Per node: earliest certificate failure in the subtree
+    long long now_;
+};
+
+#endif // KINETIC_TOURNAMENT_HPP
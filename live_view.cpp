@@ -0,0 +1,356 @@
+#include "live_view.hpp"
+#include "spsc_ring.hpp"
+#include "sim_viewport.hpp"
+#include "arrival_order.hpp"
+#include "workload_io.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+const int SNAPSHOT_DELTAS = 256;
+const size_t SNAPSHOT_RING = 128;
+
+struct LiveDelta {
+    int idx;
+    int remaining;
+    long long ready_since;   // Last arrival or preemption (RR queue order)
+    long long ct;            // -1 until completed
+};
+
+struct LiveSnapshot {
+    long long time;
+    int running;             // Job index, -1 when idle
+    long long merged;        // Snapshots folded into this one or earlier ones so far
+    int count;
+    LiveDelta delta[SNAPSHOT_DELTAS];
+};
+
+typedef SpscRing<LiveSnapshot, SNAPSHOT_RING> SnapshotRing;
+typedef chrono::steady_clock Clock;
+
+// --- SIMULATION SIDE ---
+// Keeps the latest state of every job and publishes what changed since the
+// last snapshot that made it into the ring
+class SnapshotPublisher : public ScheduleObserver {
+public:
+    SnapshotPublisher(const vector<Proc>& procs, SnapshotRing& ring, double speed)
+        : ring_(ring), speed_(speed), pending_head_(0), time_(0), running_(-1), header_dirty_(true),
+          published_(0), merged_(0), paced_(false) {
+        state_.resize(procs.size());
+        dirty_.assign(procs.size(), 0);
+        for (size_t i = 0; i < procs.size(); ++i) {
+            LiveDelta d = {(int)i, procs[i].bt, procs[i].at, -1};
+            state_[i] = d;
+        }
+    }
+
+    void on_arrival(int idx, long long t) {
+        state_[idx].ready_since = t;
+        touch(idx);
+        advance(t);
+    }
+
+    void on_run(int, int idx, long long start, long long end) {
+        running_ = idx;
+        header_dirty_ = true;
+        if (speed_ <= 0) {
+            state_[idx].remaining -= (int)(end - start);
+            touch(idx);
+            advance(end);
+            return;
+        }
+        // Paced: show the segment in steps of about one frame
+        long long step = max(1LL, (long long)(speed_ / 30));
+        for (long long s = start; s < end; s += step) {
+            long long e = min(end, s + step);
+            state_[idx].remaining -= (int)(e - s);
+            touch(idx);
+            advance(e);
+        }
+    }
+
+    void on_preempt(int, int idx, long long t, PreemptReason) {
+        state_[idx].ready_since = t;
+        touch(idx);
+        running_ = -1;
+        advance(t);
+    }
+
+    void on_complete(int, int idx, long long t, long long) {
+        state_[idx].remaining = 0;
+        state_[idx].ct = t;
+        touch(idx);
+        running_ = -1;
+        advance(t);
+    }
+
+    // Delivers whatever is still pending, waiting for ring space if needed
+    void flush() {
+        while (header_dirty_ || has_pending()) {
+            if (!publish()) this_thread::yield();
+        }
+    }
+
+    long long published() const { return published_; }
+    long long merged() const { return merged_; }
+
+private:
+    bool has_pending() const { return pending_head_ < pending_.size(); }
+
+    void touch(int idx) {
+        if (!dirty_[idx]) {
+            dirty_[idx] = 1;
+            pending_.push_back(idx);
+        }
+    }
+
+    void advance(long long t) {
+        if (t > time_) {
+            time_ = t;
+            header_dirty_ = true;
+        }
+        if (speed_ > 0) pace();
+        if ((header_dirty_ || has_pending()) && !publish()) merged_++;
+    }
+
+    // Sleeps until simulated time_ is due on the wall clock
+    void pace() {
+        if (!paced_) {
+            paced_ = true;
+            start_wall_ = Clock::now();
+            start_time_ = time_;
+            return;
+        }
+        double due = (double)(time_ - start_time_) / speed_;
+        this_thread::sleep_until(start_wall_ + chrono::duration_cast<Clock::duration>(chrono::duration<double>(due)));
+    }
+
+    // False when the ring is full (the changes stay pending)
+    bool publish() {
+        LiveSnapshot* s = ring_.claim();
+        if (!s) return false;
+        s->time = time_;
+        s->running = running_;
+        s->merged = merged_;
+        s->count = 0;
+        // Oldest change first, so the renderer sees completions in order
+        while (has_pending() && s->count < SNAPSHOT_DELTAS) {
+            int idx = pending_[pending_head_++];
+            dirty_[idx] = 0;
+            s->delta[s->count++] = state_[idx];
+        }
+        if (!has_pending()) {
+            pending_.clear();
+            pending_head_ = 0;
+        }
+        ring_.publish();
+        header_dirty_ = false;
+        published_++;
+        return true;
+    }
+
+    SnapshotRing& ring_;
+    double speed_;
+    vector<LiveDelta> state_;
+    vector<char> dirty_;
+    vector<int> pending_;        // Changed jobs not yet published, from pending_head_ on
+    size_t pending_head_;
+    long long time_;
+    int running_;
+    bool header_dirty_;
+    long long published_;
+    long long merged_;
+    bool paced_;
+    Clock::time_point start_wall_;
+    long long start_time_;
+};
+
+// --- RENDER SIDE ---
+// The viewport's ready set ordered like the engine's ready queue; SRTF and RR
+// re-key jobs from the snapshots (remaining time, requeue time)
+static ReadyOrder ready_order(AlgoId algo) {
+    switch (algo) {
+        case ALGO_SJF_NP:
+        case ALGO_SRTF:        return READY_BY_BURST;
+        case ALGO_PRIORITY_NP: return READY_BY_PRIORITY;
+        default:               return READY_BY_ARRIVAL;
+    }
+}
+
+class SnapshotRenderer {
+public:
+    SnapshotRenderer(const vector<Proc>& procs, AlgoId algo)
+        : procs_(procs), algo_(algo), view_(procs, ready_order(algo)), time_(0), running_(-1), received_(0), merged_(0) {
+        done_.assign(procs.size(), 0);
+    }
+
+    // Applies every snapshot in the ring; only the newest clock is kept.
+    // Merged snapshots list jobs by first change, so completions are
+    // replayed in completion-time order.
+    void drain(SnapshotRing& ring) {
+        finished_.clear();
+        while (const LiveSnapshot* s = ring.front()) {
+            for (int k = 0; k < s->count; ++k) apply(s->delta[k]);
+            time_ = s->time;
+            running_ = s->running;
+            merged_ = s->merged;
+            ring.pop();
+            received_++;
+        }
+        stable_sort(finished_.begin(), finished_.end(),
+                    [](const LiveDelta& a, const LiveDelta& b) { return a.ct < b.ct; });
+        for (size_t k = 0; k < finished_.size(); ++k) view_.complete(procs_[finished_[k].idx].no, finished_[k].ct);
+        view_.set_time(time_);
+        view_.set_running(running_ >= 0 ? procs_[running_].no : -1);
+    }
+
+    void draw(const string& title) {
+        view_.render(title);
+    }
+
+    long long received() const { return received_; }
+    long long merged() const { return merged_; }
+
+private:
+    void apply(const LiveDelta& d) {
+        const Proc& p = procs_[d.idx];
+        if (algo_ == ALGO_SRTF) view_.set_ready_key(p.no, d.remaining, p.at);
+        else if (algo_ == ALGO_RR) view_.set_ready_key(p.no, d.ready_since, d.idx);
+        if (d.ct >= 0 && !done_[d.idx]) {
+            done_[d.idx] = 1;
+            finished_.push_back(d);
+        } else if (!done_[d.idx]) {
+            view_.set_progress(p.no, p.bt <= 0 ? 100 : (int)((long long)(p.bt - d.remaining) * 100 / p.bt));
+        }
+    }
+
+    const vector<Proc>& procs_;
+    AlgoId algo_;
+    SimViewport view_;
+    vector<char> done_;
+    vector<LiveDelta> finished_;   // Completions seen by the current drain
+    long long time_;
+    int running_;
+    long long received_;
+    long long merged_;
+};
+
+} // namespace
+
+AlgoResult run_live_view(const vector<Proc>& procs, AlgoId algo, int quantum, double speed, int fps,
+                         LiveViewStats* stats) {
+    unique_ptr<SnapshotRing> ring(new SnapshotRing());
+    SnapshotPublisher publisher(procs, *ring, speed);
+    atomic<bool> finished(false);
+    AlgoResult result;
+    Clock::time_point start = Clock::now();
+
+    thread simulation([&] {
+        vector<int> order = arrival_order(procs);
+        StreamEngine engine(algo, quantum);
+        engine.set_observer(&publisher);
+        for (size_t i = 0; i < order.size(); ++i) engine.feed(procs[order[i]], order[i]);
+        engine.finish();
+        publisher.flush();
+        result = engine.result((long long)procs.size());
+        finished.store(true, memory_order_release);
+    });
+
+    SnapshotRenderer renderer(procs, algo);
+    string title = "Live View: " + algo_display_name(algo, quantum);
+    Clock::duration period = chrono::duration_cast<Clock::duration>(chrono::duration<double>(1.0 / max(1, fps)));
+    Clock::time_point next_frame = Clock::now();
+    long long frames = 0;
+    for (;;) {
+        // Everything is published before finished is set, so this drain sees the end state
+        bool last = finished.load(memory_order_acquire);
+        renderer.drain(*ring);
+        renderer.draw(title);
+        frames++;
+        cout << "Frame " << frames << " | " << renderer.received() << " snapshots received, "
+             << renderer.merged() << " merged while the ring was full" << endl;
+        if (last) break;
+        next_frame += period;
+        Clock::time_point now = Clock::now();
+        if (next_frame < now) next_frame = now;   // Behind: skip the missed frames
+        this_thread::sleep_until(next_frame);
+    }
+    simulation.join();
+
+    if (stats) {
+        stats->snapshots = publisher.published();
+        stats->merged = publisher.merged();
+        stats->frames = frames;
+        stats->seconds = chrono::duration<double>(Clock::now() - start).count();
+    }
+    return result;
+}
+
+// --- MENU ENTRY ---
+// Speed prompt, run and report, shared with the visual modes
+static void run_live_and_report(const vector<Proc>& procs, AlgoId algo, int quantum) {
+    double speed;
+    cout << "Simulated seconds per real second (0 = as fast as possible): ";
+    if (!(cin >> speed) || speed < 0) {
+        cout << "Invalid speed. Running as fast as possible." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        speed = 0;
+    }
+
+    LiveViewStats stats;
+    AlgoResult r = run_live_view(procs, algo, quantum, speed, 20, &stats);
+    print_comparison_table(vector<AlgoResult>(1, r));
+    cout << stats.snapshots << " snapshots published, " << stats.merged << " merged while the renderer was behind, "
+         << stats.frames << " frames drawn in " << stats.seconds << " s." << endl;
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
+
+bool run_visual_mode_live(const vector<Proc>& procs, AlgoId algo, int quantum) {
+    if ((int)procs.size() < LIVE_VIEW_MIN_JOBS) return false;
+    cout << "\n" << procs.size() << " processes: the run is simulated on its own thread and drawn by the live view." << endl;
+    run_live_and_report(procs, algo, quantum);
+    return true;
+}
+
+void run_live_view_menu() {
+    cout << "\n<-- Live View of a Large Workload Selected -->" << endl;
+    vector<Proc> procs;
+    if (!prompt_workload(procs)) {
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "\nPress Enter to return to main menu...";
+        cin.get();
+        return;
+    }
+
+    int choice;
+    cout << "Algorithm (1=FCFS, 2=SJF NP, 3=Priority NP, 4=SRTF, 5=RR): ";
+    if (!(cin >> choice) || choice < 1 || choice > 5) {
+        cout << "Invalid algorithm. Using FCFS." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        choice = 1;
+    }
+    AlgoId algo = (AlgoId)(choice - 1);
+
+    int quantum = 0;
+    if (algo == ALGO_RR) {
+        cout << "Enter Time Quantum (Q) for Round Robin: ";
+        if (!(cin >> quantum) || quantum <= 0) {
+            cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+            cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            quantum = 2;
+        }
+    }
+
+    run_live_and_report(procs, algo, quantum);
+}
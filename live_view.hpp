@@ -0,0 +1,38 @@
+#ifndef LIVE_VIEW_HPP
+#define LIVE_VIEW_HPP
+
+#include <vector>
+#include "stream_engine.hpp"
+
+struct LiveViewStats {
+    long long snapshots;    // Published by the simulation thread
+    long long merged;       // Folded into a later snapshot because the ring was full
+    long long frames;       // Drawn by the renderer
+    double seconds;
+};
+
+// Runs one algorithm on a simulation thread while the calling thread draws
+// it. The simulation publishes compact snapshots (clock, running job, the
+// jobs whose remaining time or state changed) through a lock-free SPSC ring
+// and never waits for the terminal: when the ring is full, the changes are
+// folded into its next snapshot. The renderer wakes `fps` times a second,
+// applies every snapshot that arrived since the last frame and draws only
+// the newest state with SimViewport, so frames are dropped, never queued.
+// speed: simulated seconds per real second, 0 = as fast as possible.
+AlgoResult run_live_view(const std::vector<Proc>& procs, AlgoId algo, int quantum, double speed, int fps,
+                         LiveViewStats* stats = 0);
+
+// Visual-mode workloads from this size are handed to the live view: the
+// modes' own loop draws and sleeps on the simulation thread, one second per
+// simulated tick, which no longer makes sense for runs this long
+const int LIVE_VIEW_MIN_JOBS = 1000;
+
+// The visual modes' path for LIVE_VIEW_MIN_JOBS processes or more: asks for
+// a speed, shows the run with run_live_view and prints its results. Returns
+// false, doing nothing, for smaller workloads, which keep their animation.
+bool run_visual_mode_live(const std::vector<Proc>& procs, AlgoId algo, int quantum);
+
+// Menu entry
+void run_live_view_menu();
+
+#endif // LIVE_VIEW_HPP
@@ -4,9 +4,24 @@
 #include "srtf_preemptive.hpp"       
 #include "round_robin.hpp"         
 #include "comparison_tool.hpp"   
+#include "io_burst_scheduler.hpp"
+#include "trace_export.hpp"
+#include "rr_quantum_search.hpp"
+#include "batch_compare.hpp"
+#include "results_export.hpp"
+#include "checkpoint.hpp"
+#include "sweep_runner.hpp"
+#include "fused_compare.hpp"
+#include "burst_predictor.hpp"
+#include "external_sort.hpp"
+#include "live_view.hpp"
+#include "multicore_sim.hpp"
+#include "energy_model.hpp"
+#include "trace_codec.hpp"
 #include "scheduler_common.hpp" 
 #include <iostream>
 #include <limits> 
+#include <string>
 
 void display_menu() {
     clearScreen();
@@ -18,11 +33,29 @@ void display_menu() {
     std::cout << "4. Shortest Remaining Time First (SRTF) Algorithm (Preemptive)" << std::endl; 
     std::cout << "5. Round Robin (RR) Scheduling Algorithm (Preemptive)" << std::endl; 
     std::cout << "6. Compare All Algorithms (Fast Calculation)" << std::endl; // NEW OPTION
+    std::cout << "7. Compare All Algorithms on CPU/I-O Burst Workloads" << std::endl;
+    std::cout << "8. Export Schedule as Chrome Trace (Perfetto)" << std::endl;
+    std::cout << "9. Find the Best Round Robin Quantum" << std::endl;
+    std::cout << "10. Batch Compare a Directory of Traces" << std::endl;
+    std::cout << "11. Export Per-Process Results (CSV / Columnar)" << std::endl;
+    std::cout << "12. Long-Running Simulation with Checkpoints" << std::endl;
+    std::cout << "13. Parameter Sweep on Worker Processes" << std::endl;
+    std::cout << "14. Compare All Algorithms on a Streamed Trace (Single Pass)" << std::endl;
+    std::cout << "15. SJF / SRTF with Predicted Burst Times" << std::endl;
+    std::cout << "16. Compare All Algorithms on a Trace Larger than RAM" << std::endl;
+    std::cout << "17. Live View of a Large Workload" << std::endl;
+    std::cout << "18. Multi-Core Round Robin with Processor Affinity" << std::endl;
+    std::cout << "19. Energy Report (DVFS and Sleep States)" << std::endl;
+    std::cout << "20. Compress a Trace File" << std::endl;
     std::cout << "0. Exit" << std::endl;
     std::cout << "Enter choice: ";
 }
 
-int main() {
+int main(int argc, char** argv) {
+    if (argc == 3 && std::string(argv[1]) == "--resume") {
+        return run_resume_command(argv[2]);
+    }
+
     int choice;
 
     do {
@@ -53,12 +86,54 @@ int main() {
             case 6: // NEW CASE
                 run_all_algorithms_comparison();
                 break;
+            case 7:
+                run_io_burst_comparison();
+                break;
+            case 8:
+                run_trace_export();
+                break;
+            case 9:
+                run_quantum_search();
+                break;
+            case 10:
+                run_batch_compare_menu();
+                break;
+            case 11:
+                run_results_export();
+                break;
+            case 12:
+                run_checkpointed_simulation();
+                break;
+            case 13:
+                run_sweep_menu();
+                break;
+            case 14:
+                run_streamed_comparison();
+                break;
+            case 15:
+                run_burst_prediction();
+                break;
+            case 16:
+                run_out_of_core_comparison();
+                break;
+            case 17:
+                run_live_view_menu();
+                break;
+            case 18:
+                run_multicore_comparison();
+                break;
+            case 19:
+                run_energy_report();
+                break;
+            case 20:
+                run_trace_compression();
+                break;
             case 0:
                 std::cout << "\nExiting the simulator. Goodbye!\n";
                 break;
             default:
                 clearScreen();
-                std::cout << "Invalid choice. Please enter 1, 2, 3, 4, 5, 6, or 0.\n";
+                std::cout << "Invalid choice. Please enter 1 to 20, or 0.\n";
                 std::cout << "Press Enter to try again...";
                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                 std::cin.get();
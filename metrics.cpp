@@ -0,0 +1,251 @@
+#include "metrics.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+#ifndef _WIN32
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+// --- METRICS ---
+MetricHistogram::MetricHistogram(const vector<double>& bounds)
+    : bounds_(bounds), counts_(new atomic<long long>[bounds.size() + 1]), sum_micros_(0) {
+    for (size_t i = 0; i <= bounds_.size(); ++i) counts_[i].store(0);
+}
+
+void MetricHistogram::observe(double v) {
+    size_t i = 0;
+    while (i < bounds_.size() && v > bounds_[i]) ++i;
+    counts_[i].fetch_add(1, memory_order_relaxed);
+    sum_micros_.fetch_add(llround(v * 1e6), memory_order_relaxed);
+}
+
+long long MetricHistogram::count() const {
+    long long total = 0;
+    for (size_t i = 0; i <= bounds_.size(); ++i) total += bucket(i);
+    return total;
+}
+
+vector<double> exponential_buckets(double start, double factor, int count) {
+    vector<double> bounds;
+    for (int i = 0; i < count; ++i, start *= factor) bounds.push_back(start);
+    return bounds;
+}
+
+// --- REGISTRY ---
+MetricsRegistry::Entry* MetricsRegistry::find(const string& name, const string& labels) {
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i].name == name && entries_[i].labels == labels) return &entries_[i];
+    }
+    return 0;
+}
+
+MetricCounter& MetricsRegistry::counter(const string& name, const string& help, const string& labels) {
+    lock_guard<mutex> lock(mutex_);
+    if (Entry* e = find(name, labels)) return *static_cast<MetricCounter*>(e->metric);
+    counters_.emplace_back();
+    Entry e = {name, help, labels, COUNTER, &counters_.back()};
+    entries_.push_back(e);
+    return counters_.back();
+}
+
+MetricGauge& MetricsRegistry::gauge(const string& name, const string& help, const string& labels) {
+    lock_guard<mutex> lock(mutex_);
+    if (Entry* e = find(name, labels)) return *static_cast<MetricGauge*>(e->metric);
+    gauges_.emplace_back();
+    Entry e = {name, help, labels, GAUGE, &gauges_.back()};
+    entries_.push_back(e);
+    return gauges_.back();
+}
+
+MetricHistogram& MetricsRegistry::histogram(const string& name, const string& help, const vector<double>& bounds,
+                                            const string& labels) {
+    lock_guard<mutex> lock(mutex_);
+    if (Entry* e = find(name, labels)) return *static_cast<MetricHistogram*>(e->metric);
+    histograms_.emplace_back(bounds);
+    Entry e = {name, help, labels, HISTOGRAM, &histograms_.back()};
+    entries_.push_back(e);
+    return histograms_.back();
+}
+
+// Joins a label set with one more label
+static string with_label(const string& labels, const string& extra) {
+    return "{" + labels + (labels.empty() ? "" : ",") + extra + "}";
+}
+
+string MetricsRegistry::exposition() {
+    lock_guard<mutex> lock(mutex_);
+    ostringstream out;
+    out.precision(17);
+    vector<bool> written(entries_.size(), false);
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (written[i]) continue;
+        const Entry& family = entries_[i];
+        static const char* const type[] = {"counter", "gauge", "histogram"};
+        out << "# HELP " << family.name << " " << family.help << "\n";
+        out << "# TYPE " << family.name << " " << type[family.kind] << "\n";
+        for (size_t j = i; j < entries_.size(); ++j) {
+            const Entry& e = entries_[j];
+            if (e.name != family.name) continue;
+            written[j] = true;
+            string labels = e.labels.empty() ? "" : "{" + e.labels + "}";
+            if (e.kind == COUNTER) {
+                out << e.name << labels << " " << static_cast<MetricCounter*>(e.metric)->value() << "\n";
+            } else if (e.kind == GAUGE) {
+                out << e.name << labels << " " << static_cast<MetricGauge*>(e.metric)->value() << "\n";
+            } else {
+                const MetricHistogram& h = *static_cast<MetricHistogram*>(e.metric);
+                long long cumulative = 0;
+                for (size_t b = 0; b < h.bounds().size(); ++b) {
+                    cumulative += h.bucket(b);
+                    ostringstream le;
+                    le << "le=\"" << h.bounds()[b] << "\"";
+                    out << e.name << "_bucket" << with_label(e.labels, le.str()) << " " << cumulative << "\n";
+                }
+                cumulative += h.bucket(h.bounds().size());
+                out << e.name << "_bucket" << with_label(e.labels, "le=\"+Inf\"") << " " << cumulative << "\n";
+                out << e.name << "_sum" << labels << " " << h.sum() << "\n";
+                out << e.name << "_count" << labels << " " << cumulative << "\n";
+            }
+        }
+    }
+    return out.str();
+}
+
+MetricsRegistry& metrics() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+// --- EXPORT ---
+namespace {
+
+#ifndef _WIN32
+// A slow or stalled reader cannot hold up a flush (or the final one at exit)
+// for longer than this
+const int SOCKET_SEND_TIMEOUT_SECONDS = 2;
+
+// Limits the next blocking connect/send on fd to what is left until deadline
+bool set_send_timeout(int fd, chrono::steady_clock::time_point deadline) {
+    long long left = chrono::duration_cast<chrono::microseconds>(deadline - chrono::steady_clock::now()).count();
+    if (left <= 0) return false;
+    timeval timeout = timeval();
+    timeout.tv_sec = (time_t)(left / 1000000);
+    timeout.tv_usec = (suseconds_t)(left % 1000000);
+    return setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == 0;
+}
+#endif
+
+// Resident set size, read at flush time; false where it is not available
+bool resident_bytes(double& bytes) {
+#ifdef __linux__
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (!f) return false;
+    long long pages_total, pages_resident;
+    bool ok = fscanf(f, "%lld %lld", &pages_total, &pages_resident) == 2;
+    fclose(f);
+    if (ok) bytes = (double)pages_resident * sysconf(_SC_PAGESIZE);
+    return ok;
+#else
+    (void)bytes;
+    return false;
+#endif
+}
+
+bool write_file(const string& path, const string& text) {
+    string tmp = path + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "w");
+    if (!f) return false;
+    bool ok = fwrite(text.data(), 1, text.size(), f) == text.size();
+    if (fclose(f) != 0) ok = false;
+#ifdef _WIN32
+    remove(path.c_str());   // rename() does not replace on Windows
+#endif
+    return ok && rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool write_socket(const string& path, const string& text) {
+#ifndef _WIN32
+    sockaddr_un addr = sockaddr_un();
+    if (path.size() >= sizeof(addr.sun_path)) return false;
+    addr.sun_family = AF_UNIX;
+    path.copy(addr.sun_path, path.size());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::seconds(SOCKET_SEND_TIMEOUT_SECONDS);
+    // A listener that hangs up must fail the flush, not raise SIGPIPE and
+    // end the run being observed
+#ifdef MSG_NOSIGNAL
+    const int send_flags = MSG_NOSIGNAL;
+#else
+    const int send_flags = 0;
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    bool ok = set_send_timeout(fd, deadline) && connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+    for (size_t sent = 0; ok && sent < text.size();) {
+        ssize_t w = set_send_timeout(fd, deadline) ? send(fd, text.data() + sent, text.size() - sent, send_flags) : -1;
+        if (w <= 0) ok = false;
+        else sent += (size_t)w;
+    }
+    close(fd);
+    return ok;
+#else
+    (void)path;
+    (void)text;
+    return false;
+#endif
+}
+
+} // namespace
+
+MetricsSession::MetricsSession() : interval_(5), stopping_(false) {
+    const char* env = getenv("SIM_METRICS");
+    if (!env || !*env || string(env) == "0") return;
+    target_ = env;
+    const char* interval = getenv("SIM_METRICS_INTERVAL");
+    if (interval && atoi(interval) > 0) interval_ = atoi(interval);
+    thread_ = thread(&MetricsSession::loop, this);
+}
+
+MetricsSession::~MetricsSession() {
+    if (!active()) return;
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+    flush();
+}
+
+bool MetricsSession::flush() {
+    if (!active()) return false;
+    double rss;
+    if (resident_bytes(rss)) {
+        metrics().gauge("process_resident_memory_bytes", "Resident memory size in bytes.").set(rss);
+    }
+    static MetricCounter& failures =
+        metrics().counter("sched_metrics_export_failures_total", "Metric flushes that could not be written.");
+    string text = metrics().exposition();
+    bool ok = target_.compare(0, 5, "unix:") == 0 ? write_socket(target_.substr(5), text)
+                                                 : write_file(target_, text);
+    if (!ok) failures.add();
+    return ok;
+}
+
+void MetricsSession::loop() {
+    unique_lock<mutex> lock(mutex_);
+    while (!wake_.wait_for(lock, chrono::seconds(interval_), [&] { return stopping_; })) {
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Process-wide metrics for long batch runs, written out in the Prometheus
+// text exposition format. Registering a metric takes a lock; updating one is
+// a single relaxed atomic operation, so callers look their metrics up once
+// (e.g. into a static reference) and update them per engine run, never per
+// scheduling step.
+
+class MetricCounter {
+public:
+    MetricCounter() : value_(0) {}
+    void add(long long v = 1) { value_.fetch_add(v, std::memory_order_relaxed); }
+    long long value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<long long> value_;
+};
+
+class MetricGauge {
+public:
+    MetricGauge() : value_(0.0) {}
+    void set(double v) { value_.store(v, std::memory_order_relaxed); }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_;
+};
+
+// Cumulative buckets with fixed upper bounds; the sum is kept in micro-units
+class MetricHistogram {
+public:
+    explicit MetricHistogram(const std::vector<double>& bounds);
+    void observe(double v);
+
+    const std::vector<double>& bounds() const { return bounds_; }
+    long long bucket(std::size_t i) const { return counts_[i].load(std::memory_order_relaxed); }  // Not cumulative
+    long long count() const;
+    double sum() const { return sum_micros_.load(std::memory_order_relaxed) / 1e6; }
+
+private:
+    std::vector<double> bounds_;
+    std::unique_ptr<std::atomic<long long>[]> counts_;   // One per bound, plus +Inf
+    std::atomic<long long> sum_micros_;
+};
+
+class MetricsRegistry {
+public:
+    // The same name and labels always return the same metric. labels is the
+    // inside of the braces, e.g. engine="fcfs"; help and type come from the
+    // first registration of a name.
+    MetricCounter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    MetricGauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    MetricHistogram& histogram(const std::string& name, const std::string& help, const std::vector<double>& bounds,
+                               const std::string& labels = "");
+
+    // Current values, grouped by metric name in registration order
+    std::string exposition();
+
+private:
+    enum Kind { COUNTER, GAUGE, HISTOGRAM };
+    struct Entry {
+        std::string name, help, labels;
+        Kind kind;
+        void* metric;
+    };
+
+    Entry* find(const std::string& name, const std::string& labels);
+
+    std::mutex mutex_;
+    std::deque<Entry> entries_;
+    std::deque<MetricCounter> counters_;     // Deques keep the addresses handed out stable
+    std::deque<MetricGauge> gauges_;
+    std::deque<MetricHistogram> histograms_;
+};
+
+MetricsRegistry& metrics();
+
+// Exponential bucket bounds start, start*factor, ... (count of them)
+std::vector<double> exponential_buckets(double start, double factor, int count);
+
+// Periodic export while a long run is in progress. Enabled by SIM_METRICS:
+// a file path (written to path.tmp and renamed, so node exporter's textfile
+// collector never reads half a file) or unix:/path of a Unix-domain stream
+// socket that receives the full text on every flush (a listener that hangs
+// up, or has not taken the text within 2 s, fails that flush). SIM_METRICS_INTERVAL
+// sets the period in seconds (default 5). A final flush happens when the
+// session ends. Without SIM_METRICS the session does nothing.
+class MetricsSession {
+public:
+    MetricsSession();
+    ~MetricsSession();
+
+    bool active() const { return !target_.empty(); }
+    bool flush();
+
+private:
+    void loop();
+
+    std::string target_;
+    int interval_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_;
+    std::thread thread_;
+
+    MetricsSession(const MetricsSession&);
+    MetricsSession& operator=(const MetricsSession&);
+};
+
+#endif // METRICS_HPP
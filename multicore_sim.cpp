@@ -0,0 +1,340 @@
+#include "multicore_sim.hpp"
+#include "arrival_order.hpp"
+#include "workload_io.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+const int LIST_JOBS = 20;   // Per-job migration table only for workloads this small
+
+// FIFO of job slots, linked through JobLists; a job is in at most one queue
+struct JobQueue {
+    int head, tail, size;
+};
+
+struct CoreState {
+    int running;          // Job, -1 when idle
+    long long slice;      // Work done by the current dispatch
+    long long end;        // End of the dispatch, migration cost included
+    JobQueue queue;       // Per-core policies only
+};
+
+// Intrusive doubly linked lists over the jobs, so any number of queues fit
+// in O(n) memory and a job can be taken from the middle or the tail
+class JobLists {
+public:
+    JobLists(ScratchArena& scratch, int n)
+        : next_(scratch.alloc_array<int>(n)), prev_(scratch.alloc_array<int>(n)) {}
+
+    static void clear(JobQueue& q) {
+        q.head = q.tail = -1;
+        q.size = 0;
+    }
+
+    void push_back(JobQueue& q, int j) {
+        prev_[j] = q.tail;
+        next_[j] = -1;
+        if (q.tail >= 0) next_[q.tail] = j;
+        else q.head = j;
+        q.tail = j;
+        q.size++;
+    }
+
+    void remove(JobQueue& q, int j) {
+        if (prev_[j] >= 0) next_[prev_[j]] = next_[j];
+        else q.head = next_[j];
+        if (next_[j] >= 0) prev_[next_[j]] = prev_[j];
+        else q.tail = prev_[j];
+        q.size--;
+    }
+
+    int next(int j) const { return next_[j]; }
+
+private:
+    int* next_;
+    int* prev_;
+};
+
+} // namespace
+
+const char* affinity_policy_name(AffinityPolicy policy) {
+    switch (policy) {
+        case AFFINITY_NONE:        return "Global queue";
+        case AFFINITY_PREFER_LAST: return "Global, prefer last";
+        case AFFINITY_PER_CORE:    return "Per-core + stealing";
+        case AFFINITY_PINNED:
+        default:                   return "Pinned";
+    }
+}
+
+MulticoreResult simulate_multicore(const vector<Proc>& procs, const MulticoreOptions& options,
+                                   EngineContext& ctx) {
+    int n = procs.size();
+    int cores = max(1, options.cores);
+    long long quantum = max(1, options.quantum);
+    bool per_core = options.policy == AFFINITY_PER_CORE || options.policy == AFFINITY_PINNED;
+
+    MulticoreResult r;
+    r.summary = {affinity_policy_name(options.policy), 0.0, 0.0, 0, 0, 0, 0};
+    r.migrations = 0;
+    r.max_migrations = 0;
+    r.jobs_migrated = 0;
+    r.lost_time = 0;
+    r.busy_time = 0;
+    r.makespan = 0;
+    r.job_migrations.assign(n, 0);
+    if (n == 0) return r;
+
+    ScratchArena& scratch = ctx.begin_run();
+    int* order = scratch.alloc_array<int>(n);
+    arrival_order(procs.data(), n, order, &scratch);
+    long long* rem = scratch.alloc_array<long long>(n);
+    long long* tat = scratch.alloc_array<long long>(n);   // Jobs that never run stay 0
+    int* last_core = scratch.alloc_array<int>(n);
+    int left = 0;
+    for (int i = 0; i < n; ++i) {
+        rem[i] = procs[i].bt;
+        tat[i] = 0;
+        last_core[i] = -1;
+        if (procs[i].bt > 0) left++;
+    }
+
+    JobLists lists(scratch, n);
+    JobQueue global;
+    JobLists::clear(global);
+    CoreState* core = scratch.alloc_array<CoreState>(cores);
+    for (int c = 0; c < cores; ++c) {
+        core[c].running = -1;
+        core[c].slice = 0;
+        core[c].end = 0;
+        JobLists::clear(core[c].queue);
+    }
+
+    // c: the core the job last ran on, -1 for a new job
+    auto place = [&](int j, int c) {
+        if (!per_core) {
+            lists.push_back(global, j);
+            return;
+        }
+        if (c < 0) {
+            int best = numeric_limits<int>::max();
+            for (int k = 0; k < cores; ++k) {
+                int load = core[k].queue.size + (core[k].running >= 0 ? 1 : 0);
+                if (load < best) {
+                    best = load;
+                    c = k;
+                }
+            }
+        }
+        lists.push_back(core[c].queue, j);
+    };
+
+    auto pick = [&](int c) {
+        JobQueue* q = per_core ? &core[c].queue : &global;
+        int j = q->head;
+        if (options.policy == AFFINITY_PREFER_LAST) {
+            int seen = 0;
+            for (int s = global.head; s >= 0 && seen < cores; s = lists.next(s), ++seen) {
+                if (last_core[s] == c) {
+                    j = s;
+                    break;
+                }
+            }
+        } else if (options.policy == AFFINITY_PER_CORE && j < 0) {
+            // Steal from the longest queue the job that would wait there longest
+            int victim = -1;
+            for (int k = 0; k < cores; ++k) {
+                if (core[k].queue.size > (victim < 0 ? 0 : core[victim].queue.size)) victim = k;
+            }
+            if (victim >= 0) {
+                q = &core[victim].queue;
+                j = q->tail;
+            }
+        }
+        if (j >= 0) lists.remove(*q, j);
+        return j;
+    };
+
+    long long t = 0, sum_tat = 0, sum_bt = 0;
+    int next = 0;
+    while (left > 0) {
+        long long t_next = numeric_limits<long long>::max();
+        if (next < n) t_next = procs[order[next]].at;
+        for (int c = 0; c < cores; ++c) {
+            if (core[c].running >= 0) t_next = min(t_next, core[c].end);
+        }
+        if (t_next == numeric_limits<long long>::max()) break;
+        t = t_next;
+
+        // Arrivals first: they queue ahead of the jobs preempted at t
+        while (next < n && procs[order[next]].at <= t) {
+            int j = order[next++];
+            if (procs[j].bt > 0) place(j, -1);
+        }
+        for (int c = 0; c < cores; ++c) {
+            int j = core[c].running;
+            if (j < 0 || core[c].end != t) continue;
+            core[c].running = -1;
+            rem[j] -= core[c].slice;
+            if (rem[j] == 0) {
+                tat[j] = t - procs[j].at;
+                sum_tat += tat[j];
+                sum_bt += procs[j].bt;
+                r.makespan = t;
+                left--;
+            } else {
+                place(j, c);
+            }
+        }
+
+        for (int c = 0; c < cores; ++c) {
+            if (core[c].running >= 0) continue;
+            int j = pick(c);
+            if (j < 0) continue;
+            long long cost = 0;
+            if (last_core[j] >= 0 && last_core[j] != c) {
+                cost = max(0LL, options.migration_fixed +
+                                llround(options.migration_per_mb * procs[j].working_set / 1024.0));
+                r.migrations++;
+                if (r.job_migrations[j]++ == 0) r.jobs_migrated++;
+                r.lost_time += cost;
+            }
+            last_core[j] = c;
+            core[c].running = j;
+            core[c].slice = min(rem[j], quantum);
+            core[c].end = t + cost + core[c].slice;
+            r.busy_time += cost + core[c].slice;
+        }
+    }
+
+    long long min_tat = numeric_limits<long long>::max(), max_tat = numeric_limits<long long>::min();
+    long long min_wt = min_tat, max_wt = max_tat;
+    for (int i = 0; i < n; ++i) {
+        long long wt = procs[i].bt > 0 ? tat[i] - procs[i].bt : 0;
+        min_tat = min(min_tat, tat[i]);
+        max_tat = max(max_tat, tat[i]);
+        min_wt = min(min_wt, wt);
+        max_wt = max(max_wt, wt);
+        r.max_migrations = max(r.max_migrations, r.job_migrations[i]);
+    }
+    r.summary.avg_tat = (double)sum_tat / n;
+    r.summary.avg_wt = (double)(sum_tat - sum_bt) / n;
+    r.summary.min_tat = min_tat;
+    r.summary.max_tat = max_tat;
+    r.summary.min_wt = min_wt;
+    r.summary.max_wt = max_wt;
+    return r;
+}
+
+// --- MENU ENTRY ---
+void run_multicore_comparison() {
+    cout << "\n<-- Multi-Core Round Robin with Processor Affinity Selected -->" << endl;
+    vector<Proc> procs;
+    if (!prompt_workload(procs)) {
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "\nPress Enter to return to main menu...";
+        cin.get();
+        return;
+    }
+
+    MulticoreOptions options;
+    cout << "Number of cores: ";
+    if (!(cin >> options.cores) || options.cores <= 0) {
+        cout << "Invalid number of cores. Using 4." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        options.cores = 4;
+    }
+    cout << "Enter Time Quantum (Q) for Round Robin: ";
+    if (!(cin >> options.quantum) || options.quantum <= 0) {
+        cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        options.quantum = 2;
+    }
+    cout << "Fixed cost of one migration (seconds): ";
+    if (!(cin >> options.migration_fixed) || options.migration_fixed < 0) {
+        cout << "Invalid cost. Using 1 s." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        options.migration_fixed = 1;
+    }
+    cout << "Extra migration cost per MB of working set (seconds): ";
+    if (!(cin >> options.migration_per_mb) || options.migration_per_mb < 0) {
+        cout << "Invalid cost. Using 0.5 s per MB." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        options.migration_per_mb = 0.5;
+    }
+
+    EngineContext ctx(procs.size());
+    vector<MulticoreResult> results;
+    for (int p = 0; p < AFFINITY_POLICY_COUNT; ++p) {
+        options.policy = (AffinityPolicy)p;
+        results.push_back(simulate_multicore(procs, options, ctx));
+    }
+
+    clearScreen();
+    cout << "\n========================================================" << endl;
+    cout << "|| MULTI-CORE RR (" << options.cores << " cores, Q=" << options.quantum << "): AFFINITY AND MIGRATION ||" << endl;
+    cout << "========================================================" << endl;
+    cout << fixed << setprecision(2);
+
+    double best_wt = results[0].summary.avg_wt;
+    for (const auto& r : results) best_wt = min(best_wt, r.summary.avg_wt);
+
+    cout << left << setw(22) << "| Policy"
+         << right << setw(12) << "| Avg TAT"
+         << right << setw(12) << "| Avg WT"
+         << right << setw(13) << "| Migrations"
+         << right << setw(12) << "| Per job"
+         << right << setw(10) << "| Max"
+         << right << setw(12) << "| Lost CPU"
+         << right << setw(10) << "| Lost % |" << endl;
+    cout << "-----------------------------------------------------------------------------------------------" << endl;
+    for (const auto& r : results) {
+        bool is_best = r.summary.avg_wt == best_wt;
+        double lost_pct = r.busy_time > 0 ? 100.0 * r.lost_time / r.busy_time : 0.0;
+        cout << (is_best ? "\033[1;32m" : "")
+             << "| " << left << setw(20) << r.summary.algo_name
+             << right << setw(12) << r.summary.avg_tat
+             << right << setw(12) << r.summary.avg_wt
+             << right << setw(13) << r.migrations
+             << right << setw(12) << (double)r.migrations / procs.size()
+             << right << setw(10) << r.max_migrations
+             << right << setw(12) << r.lost_time
+             << right << setw(8) << lost_pct << " |"
+             << (is_best ? "\033[0m" : "") << endl;
+    }
+    cout << "-----------------------------------------------------------------------------------------------" << endl;
+    cout << "Lost CPU: time spent refilling caches after migrations (" << options.migration_fixed << " s + "
+         << options.migration_per_mb << " s per MB of working set each); Lost %: share of all CPU time used." << endl;
+
+    bool any_wss = false;
+    for (const auto& p : procs) any_wss = any_wss || p.working_set > 0;
+    if (!any_wss) cout << "The workload has no working-set column (WSS), so only the fixed cost is charged." << endl;
+
+    // Migrations per job
+    if ((int)procs.size() <= LIST_JOBS) {
+        cout << "\nMigrations per process:" << endl;
+        cout << left << setw(8) << "| PID" << right << setw(10) << "| WSS KB";
+        for (const auto& r : results) cout << right << setw(22) << ("| " + r.summary.algo_name);
+        cout << " |" << endl;
+        for (size_t i = 0; i < procs.size(); ++i) {
+            cout << "| " << left << setw(6) << ("P" + to_string(procs[i].no)) << right << setw(10) << procs[i].working_set;
+            for (const auto& r : results) cout << right << setw(22) << r.job_migrations[i];
+            cout << " |" << endl;
+        }
+    } else {
+        cout << "\nProcesses that migrated at least once:";
+        for (const auto& r : results) cout << "  " << r.summary.algo_name << ": " << r.jobs_migrated;
+        cout << endl;
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
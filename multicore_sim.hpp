@@ -0,0 +1,53 @@
+#ifndef MULTICORE_SIM_HPP
+#define MULTICORE_SIM_HPP
+
+#include <vector>
+#include "comparison_tool.hpp"
+#include "engine_context.hpp"
+
+// Where a free core looks for its next job
+enum AffinityPolicy {
+    AFFINITY_NONE,         // One global RR queue, the head goes to any free core
+    AFFINITY_PREFER_LAST,  // Global queue, but a core first takes a job that last ran on it
+                           // from the first `cores` queued jobs
+    AFFINITY_PER_CORE,     // A queue per core; idle cores steal from the longest queue
+    AFFINITY_PINNED,       // A queue per core and no stealing: jobs never migrate
+    AFFINITY_POLICY_COUNT
+};
+
+struct MulticoreOptions {
+    int cores;
+    int quantum;
+    AffinityPolicy policy;
+    int migration_fixed;      // Charged whenever a job runs on another core than last time
+    double migration_per_mb;  // Plus this much per MB of the job's working set (Proc::working_set)
+};
+
+struct MulticoreResult {
+    AlgoResult summary;
+    long long migrations;
+    int max_migrations;               // Of a single job
+    long long jobs_migrated;          // Jobs that moved at least once
+    long long lost_time;              // CPU time spent refilling caches after migrations
+    long long busy_time;              // All CPU time used, lost time included
+    long long makespan;               // Last completion
+    std::vector<int> job_migrations;  // Per process, indexed like the input
+};
+
+// Round Robin on `cores` identical cores. Each job remembers the core it last
+// ran on; running it on a different one first costs
+//   migration_fixed + migration_per_mb * working_set / 1024
+// (rounded) of CPU time on the new core, which shows up in TAT and WT.
+// New jobs are placed on the core with the fewest jobs (per-core policies)
+// and preempted jobs go back to the queue of the core they ran on. Arrivals
+// during or at the end of a slice are queued ahead of the preempted job, as
+// in the single-core engines; jobs with bt <= 0 never run and count as 0.
+MulticoreResult simulate_multicore(const std::vector<Proc>& procs, const MulticoreOptions& options,
+                                   EngineContext& ctx);
+
+const char* affinity_policy_name(AffinityPolicy policy);
+
+// Menu entry: every placement policy on one workload
+void run_multicore_comparison();
+
+#endif // MULTICORE_SIM_HPP
@@ -0,0 +1,82 @@
+#include "order_statistic.hpp"
+
+using namespace std;
+
+OrderStatisticTree::OrderStatisticTree(ScratchArena& arena, int capacity) : root_(-1) {
+    if (capacity < 1) capacity = 1;
+    node_ = arena.alloc_array<Node>(capacity);
+    for (int i = 0; i < capacity; ++i) {
+        // Fixed pseudo-random priority per slot (integer hash), so runs repeat exactly
+        unsigned h = (unsigned)i * 0x9E3779B9u;
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        node_[i].prio = h;
+    }
+}
+
+void OrderStatisticTree::split(int node, int id, int& lo, int& hi) {
+    if (node < 0) {
+        lo = hi = -1;
+    } else if (before(node, id)) {
+        split(node_[node].right, id, node_[node].right, hi);
+        lo = node;
+        update(node);
+    } else {
+        split(node_[node].left, id, lo, node_[node].left);
+        hi = node;
+        update(node);
+    }
+}
+
+int OrderStatisticTree::merge(int lo, int hi) {
+    if (lo < 0) return hi;
+    if (hi < 0) return lo;
+    if (node_[lo].prio > node_[hi].prio) {
+        node_[lo].right = merge(node_[lo].right, hi);
+        update(lo);
+        return lo;
+    }
+    node_[hi].left = merge(lo, node_[hi].left);
+    update(hi);
+    return hi;
+}
+
+// Both walk down once, fixing the sizes on the way, and only split or merge
+// the subtree below the node's position (expected O(1) nodes)
+void OrderStatisticTree::insert(int id, long long key) {
+    Node& n = node_[id];
+    n.key = key;
+    int* link = &root_;
+    while (*link >= 0 && node_[*link].prio > n.prio) {
+        node_[*link].count++;
+        link = before(id, *link) ? &node_[*link].left : &node_[*link].right;
+    }
+    split(*link, id, n.left, n.right);
+    update(id);
+    *link = id;
+}
+
+void OrderStatisticTree::erase(int id) {
+    int* link = &root_;
+    while (*link != id) {
+        node_[*link].count--;
+        link = before(id, *link) ? &node_[*link].left : &node_[*link].right;
+    }
+    *link = merge(node_[id].left, node_[id].right);
+}
+
+long long OrderStatisticTree::kth(int k) const {
+    int node = root_;
+    for (;;) {
+        int left_count = count(node_[node].left);
+        if (k < left_count) {
+            node = node_[node].left;
+        } else if (k == left_count) {
+            return node_[node].key;
+        } else {
+            k -= left_count + 1;
+            node = node_[node].right;
+        }
+    }
+}
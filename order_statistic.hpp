@@ -0,0 +1,43 @@
+#ifndef ORDER_STATISTIC_HPP
+#define ORDER_STATISTIC_HPP
+
+#include "engine_context.hpp"
+
+// Multiset of (key, id) pairs with rank queries, for percentiles of a set
+// that changes one element at a time. It is a treap over node slots that are
+// the ids themselves, so an id can be present at most once and nothing is
+// allocated after construction. Every subtree keeps its size, which makes
+// insert, erase and kth O(log n) expected. Equal keys are ordered by id.
+class OrderStatisticTree {
+public:
+    // Ids are 0..capacity-1; all memory comes from the arena
+    OrderStatisticTree(ScratchArena& arena, int capacity);
+
+    void insert(int id, long long key);   // id must not be present
+    void erase(int id);                   // id must be present
+
+    long long kth(int k) const;           // k-th smallest key, 0-based, k < size()
+    int size() const { return root_ < 0 ? 0 : node_[root_].count; }
+
+private:
+    // One cache line holds a whole node, so a step down the tree is one miss
+    struct Node {
+        long long key;
+        unsigned prio;     // Heap order: parents have the larger priority
+        int left, right;
+        int count;         // Subtree size
+    };
+
+    bool before(int a, int b) const {
+        return node_[a].key != node_[b].key ? node_[a].key < node_[b].key : a < b;
+    }
+    int count(int node) const { return node < 0 ? 0 : node_[node].count; }
+    void update(int node) { node_[node].count = 1 + count(node_[node].left) + count(node_[node].right); }
+    void split(int node, int id, int& lo, int& hi);   // lo: before id, hi: the rest
+    int merge(int lo, int hi);                        // Every node of lo is before hi
+
+    Node* node_;
+    int root_;
+};
+
+#endif // ORDER_STATISTIC_HPP
@@ -0,0 +1,191 @@
+#include "perf_counters.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <iomanip>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef __linux__
+
+static int open_counter(unsigned long long config) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;  // Allowed with perf_event_paranoid <= 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+PerfCounters::PerfCounters() : running_(false), wall_ms_(0.0) {
+    static const unsigned long long configs[PERF_EVENT_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+    int first_errno = 0;
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        fd_[e] = open_counter(configs[e]);
+        if (fd_[e] < 0 && first_errno == 0) first_errno = errno;
+    }
+    if (!any_available()) {
+        reason_ = string("perf_event_open: ") + strerror(first_errno);
+        if (first_errno == EACCES || first_errno == EPERM) reason_ += " (check /proc/sys/kernel/perf_event_paranoid)";
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        if (fd_[e] >= 0) close(fd_[e]);
+    }
+}
+
+void PerfCounters::start() {
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        if (fd_[e] >= 0) ioctl(fd_[e], PERF_EVENT_IOC_RESET, 0);
+    }
+    wall_ms_ = 0.0;
+    running_ = false;
+    resume();
+}
+
+void PerfCounters::pause() {
+    if (!running_) return;
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        if (fd_[e] >= 0) ioctl(fd_[e], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    wall_ms_ += chrono::duration<double, milli>(chrono::steady_clock::now() - resumed_at_).count();
+    running_ = false;
+}
+
+void PerfCounters::resume() {
+    if (running_) return;
+    running_ = true;
+    resumed_at_ = chrono::steady_clock::now();
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        if (fd_[e] >= 0) ioctl(fd_[e], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfSample PerfCounters::stop() {
+    pause();
+    PerfSample s;
+    s.wall_ms = wall_ms_;
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        s.valid[e] = false;
+        s.count[e] = 0;
+        if (fd_[e] < 0) continue;
+
+        unsigned long long buf[3];  // value, time_enabled, time_running
+        if (read(fd_[e], buf, sizeof(buf)) != (ssize_t)sizeof(buf)) continue;
+        if (buf[2] == 0) {
+            // Never scheduled onto a PMU (all slots taken by other events)
+            continue;
+        }
+        s.valid[e] = true;
+        s.count[e] = buf[2] < buf[1] ? (unsigned long long)((double)buf[0] * buf[1] / buf[2]) : buf[0];
+    }
+    return s;
+}
+
+#else // !__linux__
+
+PerfCounters::PerfCounters() : running_(false), wall_ms_(0.0), reason_("hardware counters need Linux perf_event_open") {
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) fd_[e] = -1;
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {
+    wall_ms_ = 0.0;
+    running_ = false;
+    resume();
+}
+
+void PerfCounters::pause() {
+    if (!running_) return;
+    wall_ms_ += chrono::duration<double, milli>(chrono::steady_clock::now() - resumed_at_).count();
+    running_ = false;
+}
+
+void PerfCounters::resume() {
+    if (running_) return;
+    running_ = true;
+    resumed_at_ = chrono::steady_clock::now();
+}
+
+PerfSample PerfCounters::stop() {
+    pause();
+    PerfSample s;
+    s.wall_ms = wall_ms_;
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        s.valid[e] = false;
+        s.count[e] = 0;
+    }
+    return s;
+}
+
+#endif // __linux__
+
+bool PerfCounters::any_available() const {
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        if (fd_[e] >= 0) return true;
+    }
+    return false;
+}
+
+bool perf_profiling_enabled() {
+    const char* v = getenv("SIM_PERF");
+    return v && *v && strcmp(v, "0") != 0;
+}
+
+static void print_count(const PerfSample& s, PerfEvent e, int width) {
+    if (s.valid[e]) cout << right << setw(width) << s.count[e];
+    else cout << right << setw(width) << "n/a";
+}
+
+void print_perf_table(const vector<string>& labels, const vector<PerfSample>& samples,
+                      const string& unavailable_reason) {
+    cout << "\n--- Hardware Counters (SIM_PERF) ---" << endl;
+    if (!unavailable_reason.empty()) {
+        cout << "Counters unavailable: " << unavailable_reason << ". Showing wall time only." << endl;
+    }
+
+    cout << left << setw(20) << "| Algorithm"
+         << right << setw(12) << "Wall (ms)"
+         << right << setw(15) << "Cycles"
+         << right << setw(15) << "Instructions"
+         << right << setw(7) << "IPC"
+         << right << setw(13) << "Cache Miss"
+         << right << setw(13) << "Branch Miss" << " |" << endl;
+    cout << string(97, '-') << endl;
+
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const PerfSample& s = samples[i];
+        cout << "| " << left << setw(18) << labels[i]
+             << right << setw(12) << fixed << setprecision(3) << s.wall_ms;
+        print_count(s, PERF_CYCLES, 15);
+        print_count(s, PERF_INSTRUCTIONS, 15);
+        if (s.valid[PERF_CYCLES] && s.valid[PERF_INSTRUCTIONS] && s.count[PERF_CYCLES] > 0) {
+            cout << right << setw(7) << setprecision(2)
+                 << (double)s.count[PERF_INSTRUCTIONS] / s.count[PERF_CYCLES];
+        } else {
+            cout << right << setw(7) << "n/a";
+        }
+        print_count(s, PERF_CACHE_MISSES, 13);
+        print_count(s, PERF_BRANCH_MISSES, 13);
+        cout << " |" << endl;
+    }
+    cout << string(97, '-') << endl;
+}
@@ -0,0 +1,73 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+// Hardware counters read around one engine run
+enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_EVENT_COUNT
+};
+
+struct PerfSample {
+    bool valid[PERF_EVENT_COUNT];            // false: counter could not be opened
+    unsigned long long count[PERF_EVENT_COUNT];
+    double wall_ms;                          // Time spent while counting
+};
+
+// Per-thread counters via Linux perf_event_open. Every event is opened on its
+// own so that a missing one (common in VMs) does not hide the others; counts
+// are scaled when the kernel had to multiplex them. On other platforms, or
+// when perf_event_paranoid forbids it, only the wall time is reported.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    void start();          // Zero and enable
+    void pause();          // Stop counting (e.g. while rendering a frame)
+    void resume();
+    PerfSample stop();
+
+    bool any_available() const;
+    // Why no hardware counter is available ("" when some are)
+    const std::string& unavailable_reason() const { return reason_; }
+
+private:
+    int fd_[PERF_EVENT_COUNT];
+    bool running_;
+    std::chrono::steady_clock::time_point resumed_at_;
+    double wall_ms_;
+    std::string reason_;
+
+    PerfCounters(const PerfCounters&);
+    PerfCounters& operator=(const PerfCounters&);
+};
+
+// Pauses the counters for the enclosed scope; null is a no-op
+class PerfPause {
+public:
+    explicit PerfPause(PerfCounters* counters) : counters_(counters) {
+        if (counters_) counters_->pause();
+    }
+    ~PerfPause() {
+        if (counters_) counters_->resume();
+    }
+
+private:
+    PerfCounters* counters_;
+};
+
+// Profiling is opt-in: set SIM_PERF=1 in the environment
+bool perf_profiling_enabled();
+
+// One row per profiled run, printed under the results table
+void print_perf_table(const std::vector<std::string>& labels, const std::vector<PerfSample>& samples,
+                      const std::string& unavailable_reason);
+
+#endif // PERF_COUNTERS_HPP
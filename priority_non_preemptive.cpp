@@ -1,10 +1,14 @@
 #include "priority_non_preemptive.hpp"
+#include "perf_counters.hpp"
+#include "sim_viewport.hpp"
+#include "live_view.hpp"
 #include <algorithm>
 #include <thread>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
 #include <limits> 
+#include <memory>
 
 using namespace std;
 
@@ -15,6 +19,8 @@ Proc read_proc_priority(int i) {
     p.progress = 0; 
     p.ct = 0;      
     p.is_completed = false; 
+    p.job_class = 0;
+    p.working_set = 0;
     
     // --- Priority Input ---
     cout << "Enter Priority (Lower number = Higher Priority): ";
@@ -74,6 +80,19 @@ void printSimulation_priority(const vector<Proc>& processes, int n, int current_
 }
 
 
+// One frame: the full listing for small workloads, the viewport otherwise.
+// running is an index into processes, or -1.
+static void show_frame_priority(SimViewport& view, const vector<Proc>& processes, int n, int current_time, int running) {
+    if (!view.active()) {
+        printSimulation_priority(processes, n, current_time);
+        return;
+    }
+    view.set_time(current_time);
+    view.set_running(running >= 0 ? processes[running].no : -1);
+    if (running >= 0) view.set_progress(processes[running].no, processes[running].progress);
+    view.render("Priority (Non-Preemptive) Scheduling Simulation");
+}
+
 // --- Main Priority Scheduling Logic ---
 void run_priority_non_preemptive_simulation() {
     int n;
@@ -89,9 +108,11 @@ void run_priority_non_preemptive_simulation() {
     for (int i = 0; i < n; ++i) {
         p.push_back(read_proc_priority(i + 1)); // Use the modified input function
     }
+    if (run_visual_mode_live(p, ALGO_PRIORITY_NP, 0)) return;
     
     // Initial sort by AT (needed for the ready queue management)
     sort(p.begin(), p.end(), compareByAT);
+    SimViewport view(p, READY_BY_PRIORITY);
 
     cout << "\nProcesses sorted. Simulation starting in 2 seconds...\n";
     this_thread::sleep_for(chrono::seconds(2));
@@ -104,6 +125,13 @@ void run_priority_non_preemptive_simulation() {
     const int total_progress_max = 100; 
     const int time_slice_ms = 20;
 
+    // Optional hardware counters (SIM_PERF=1); frames and pacing sleeps are excluded
+    unique_ptr<PerfCounters> counters;
+    if (perf_profiling_enabled()) {
+        counters.reset(new PerfCounters());
+        counters->start();
+    }
+
     // --- Priority Execution Loop ---
     while (completed_count < n) {
         
@@ -136,9 +164,10 @@ void run_priority_non_preemptive_simulation() {
             }
             
             if (next_arrival_time != -1 && current_time < next_arrival_time) {
+                 PerfPause render(counters.get());
                  int idle_start = current_time;
                  while (current_time < next_arrival_time) {
-                      printSimulation_priority(p, n, current_time);
+                      show_frame_priority(view, p, n, current_time, -1);
                       current_time++; 
                       this_thread::sleep_for(chrono::seconds(1));
                  }
@@ -158,13 +187,14 @@ void run_priority_non_preemptive_simulation() {
         long long elapsed_ms = 0;
         long long ms_per_percent = total_duration_ms / total_progress_max;
 
+        if (counters) counters->pause(); // The progress animation is all rendering
         while (p[i].progress < total_progress_max) {
             
             if (elapsed_ms >= ms_per_percent * (p[i].progress + 1)) {
                 p[i].progress++;
             }
             
-            printSimulation_priority(p, n, current_time);
+            show_frame_priority(view, p, n, current_time, i);
             
             this_thread::sleep_for(chrono::milliseconds(time_slice_ms));
             elapsed_ms += time_slice_ms;
@@ -173,26 +203,32 @@ void run_priority_non_preemptive_simulation() {
                  current_time = start_time + (elapsed_ms / 1000);
             }
         }
+        if (counters) counters->resume();
 
         // 4. Completion and Metric Update
         p[i].ct = start_time + p[i].bt;
         p[i].is_completed = true;
         completed_count++;
         current_time = p[i].ct;
+        view.complete(p[i].no, p[i].ct);
 
         p[i].tat = p[i].ct - p[i].at;
         avgtat += p[i].tat;
         p[i].wt = p[i].tat - p[i].bt;
         avgwt += p[i].wt;
         
-        printSimulation_priority(p, n, current_time);
+        if (counters) counters->pause();
+        show_frame_priority(view, p, n, current_time, -1);
         cout << "\nProcess P" << p[i].no << " Completed at T=" << p[i].ct << " (Priority " << p[i].priority << ").\n";
         this_thread::sleep_for(chrono::seconds(1)); 
+        if (counters) counters->resume();
     }
 
     // --- Final Results ---
     avgtat /= n;
     avgwt /= n;
+    PerfSample perf_sample = PerfSample();
+    if (counters) perf_sample = counters->stop();
 
     clearScreen();
     cout << "\n=== Priority Non-Preemptive Simulation Complete ===" << endl;
@@ -216,6 +252,11 @@ void run_priority_non_preemptive_simulation() {
     cout << "\n\033[1;35mAverage Turnaround Time =\033[0m " << avgtat << " seconds" << endl;
     cout << "\033[1;35mAverage Waiting Time =\033[0m " << avgwt << " seconds" << endl;
 
+    if (counters) {
+        print_perf_table(vector<string>(1, "Priority (NP)"), vector<PerfSample>(1, perf_sample),
+                         counters->unavailable_reason());
+    }
+
     cout << "\n--- Priority Simulation Finished ---\n" << endl;
     
     cin.ignore();
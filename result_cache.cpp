@@ -0,0 +1,224 @@
+#include "result_cache.hpp"
+#include "metrics.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char CACHE_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'R', 'C', '1'};
+const size_t HEADER_BYTES = 16;   // magic, engine version, record size
+const size_t RECORD_BYTES = 88;   // 24-byte key + 48-byte result + 8-byte switch count + 8-byte check value
+
+inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+template <typename T>
+void put_field(unsigned char*& p, T v) {
+    memcpy(p, &v, sizeof(v));
+    p += sizeof(v);
+}
+
+template <typename T>
+T get_field(const unsigned char*& p) {
+    T v;
+    memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    return v;
+}
+
+// Check value over a record's key and result, so a damaged record is dropped
+// instead of indexed
+uint64_t record_check(const unsigned char* rec) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL;
+    const unsigned char* p = rec;
+    for (size_t i = 0; i < (RECORD_BYTES - 8) / 8; ++i) h = mix64(h ^ get_field<uint64_t>(p));
+    return h;
+}
+
+// Cuts a torn tail off, so the next append starts on a record boundary
+bool truncate_file(const string& path, long long bytes) {
+    FILE* f = fopen(path.c_str(), "r+b");
+    if (!f) return false;
+#ifdef _WIN32
+    bool ok = _chsize_s(_fileno(f), bytes) == 0;
+#else
+    bool ok = ftruncate(fileno(f), (off_t)bytes) == 0;
+#endif
+    return fclose(f) == 0 && ok;
+}
+
+void write_header(FILE* f) {
+    unsigned char h[HEADER_BYTES];
+    unsigned char* p = h;
+    memcpy(p, CACHE_MAGIC, 8);
+    p += 8;
+    put_field<uint32_t>(p, RESULT_CACHE_ENGINE_VERSION);
+    put_field<uint32_t>(p, (uint32_t)RECORD_BYTES);
+    fwrite(h, 1, HEADER_BYTES, f);
+}
+
+bool header_matches(const unsigned char* h) {
+    const unsigned char* p = h + 8;
+    uint32_t version = get_field<uint32_t>(p);
+    uint32_t record = get_field<uint32_t>(p);
+    return memcmp(h, CACHE_MAGIC, 8) == 0 && version == RESULT_CACHE_ENGINE_VERSION && record == RECORD_BYTES;
+}
+
+} // namespace
+
+// --- WORKLOAD HASH ---
+// One multiply-xorshift round per process; order-sensitive, since the
+// engines break ties by input position.
+WorkloadHash hash_workload(const vector<Proc>& procs) {
+    uint64_t h = 0x243F6A8885A308D3ULL ^ procs.size();
+    for (const Proc& p : procs) {
+        uint64_t x = (uint64_t)(uint32_t)p.at | ((uint64_t)(uint32_t)p.bt << 32);
+        h = (h ^ mix64(x ^ ((uint64_t)(uint32_t)p.priority * 0x9E3779B97F4A7C15ULL))) * 0x100000001B3ULL;
+        h ^= h >> 29;
+    }
+    WorkloadHash w = {mix64(h), (uint64_t)procs.size()};
+    return w;
+}
+
+ResultCacheKey make_cache_key(const WorkloadHash& w, AlgoId algo, int quantum) {
+    ResultCacheKey k;
+    k.workload_hash = w.hash;
+    k.n = w.n;
+    k.algo = (int32_t)algo;
+    k.quantum = algo == ALGO_RR ? quantum : 0;
+    return k;
+}
+
+// --- ON-DISK STORE ---
+ResultCache::ResultCache() : writable_(false), hits_(0) {}
+
+bool ResultCache::open(const string& path) {
+    entries_.clear();
+    path_.clear();
+    writable_ = false;
+
+    FILE* f = fopen(path.c_str(), "rb");
+    bool fresh = true;
+    bool torn = false;
+    long long records = 0;
+    if (f) {
+        unsigned char h[HEADER_BYTES];
+        if (fread(h, 1, HEADER_BYTES, f) == HEADER_BYTES && header_matches(h)) {
+            fresh = false;
+            unsigned char rec[RECORD_BYTES];
+            size_t got;
+            while ((got = fread(rec, 1, RECORD_BYTES, f)) > 0) {
+                if (got < RECORD_BYTES) {
+                    torn = true;
+                    break;
+                }
+                ++records;
+                const unsigned char* p = rec;
+                const unsigned char* c = rec + RECORD_BYTES - 8;
+                if (get_field<uint64_t>(c) != record_check(rec)) continue;
+                ResultCacheKey k;
+                k.workload_hash = get_field<uint64_t>(p);
+                k.n = get_field<uint64_t>(p);
+                k.algo = get_field<int32_t>(p);
+                k.quantum = get_field<int32_t>(p);
+                Entry e;
+                e.avg_tat = get_field<double>(p);
+                e.avg_wt = get_field<double>(p);
+                e.min_tat = get_field<long long>(p);
+                e.max_tat = get_field<long long>(p);
+                e.min_wt = get_field<long long>(p);
+                e.max_wt = get_field<long long>(p);
+                e.switches = get_field<long long>(p);
+                entries_[k] = e;
+            }
+        }
+        fclose(f);
+    }
+
+    if (fresh) {
+        // Missing file, foreign file or older engine version: start over
+        f = fopen(path.c_str(), "wb");
+        if (!f) return false;
+        write_header(f);
+        bool ok = fclose(f) == 0;
+        if (!ok) return false;
+    }
+    path_ = path;
+    // Appending after torn bytes would misalign every later record, so a tail
+    // that cannot be cut off leaves the cache read-only
+    writable_ = !torn || truncate_file(path, (long long)(HEADER_BYTES + records * RECORD_BYTES));
+    return true;
+}
+
+bool ResultCache::lookup(const ResultCacheKey& key, AlgoResult& out, long long* switches) const {
+    static MetricCounter& hit_metric = metrics().counter("sched_result_cache_lookups_total",
+                                                         "Result cache lookups by outcome.", "result=\"hit\"");
+    static MetricCounter& miss_metric = metrics().counter("sched_result_cache_lookups_total",
+                                                          "Result cache lookups by outcome.", "result=\"miss\"");
+    unordered_map<ResultCacheKey, Entry, KeyHash>::const_iterator it = entries_.find(key);
+    if (it == entries_.end()) {
+        miss_metric.add();
+        return false;
+    }
+    hit_metric.add();
+    const Entry& e = it->second;
+    out = {algo_display_name((AlgoId)key.algo, key.quantum), e.avg_tat, e.avg_wt,
+           e.min_tat, e.max_tat, e.min_wt, e.max_wt};
+    if (switches) *switches = e.switches;
+    hits_++;
+    return true;
+}
+
+void ResultCache::store(const ResultCacheKey& key, const AlgoResult& r, long long switches) {
+    Entry e = {r.avg_tat, r.avg_wt, r.min_tat, r.max_tat, r.min_wt, r.max_wt, switches};
+    entries_[key] = e;
+    if (!writable_) return;
+
+    unsigned char rec[RECORD_BYTES];
+    unsigned char* p = rec;
+    put_field<uint64_t>(p, key.workload_hash);
+    put_field<uint64_t>(p, key.n);
+    put_field<int32_t>(p, key.algo);
+    put_field<int32_t>(p, key.quantum);
+    put_field<double>(p, e.avg_tat);
+    put_field<double>(p, e.avg_wt);
+    put_field<long long>(p, e.min_tat);
+    put_field<long long>(p, e.max_tat);
+    put_field<long long>(p, e.min_wt);
+    put_field<long long>(p, e.max_wt);
+    put_field<long long>(p, e.switches);
+    put_field<uint64_t>(p, record_check(rec));
+
+    FILE* f = fopen(path_.c_str(), "ab");
+    if (!f) return;  // Read-only location: keep the in-memory entry only
+    fwrite(rec, 1, RECORD_BYTES, f);
+    fclose(f);
+}
+
+ResultCache* default_result_cache() {
+    static ResultCache cache;
+    static bool initialised = false;
+    static bool usable = false;
+    if (!initialised) {
+        initialised = true;
+        const char* env = getenv("SIM_RESULT_CACHE");
+        string path = env && *env ? env : "scheduler_results.cache";
+        usable = path != "0" && cache.open(path);
+    }
+    return usable ? &cache : 0;
+}
@@ -0,0 +1,94 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "scheduler_common.hpp"
+#include "comparison_tool.hpp"
+#include "stream_engine.hpp"
+
+// Bump whenever a calculate_* engine changes what it returns; entries
+// written under another version are ignored.
+const std::uint32_t RESULT_CACHE_ENGINE_VERSION = 2;
+
+// 64-bit content hash of the (at, bt, priority) columns, in workload order
+struct WorkloadHash {
+    std::uint64_t hash;
+    std::uint64_t n;
+};
+
+WorkloadHash hash_workload(const std::vector<Proc>& procs);
+
+struct ResultCacheKey {
+    std::uint64_t workload_hash;
+    std::uint64_t n;
+    std::int32_t algo;
+    std::int32_t quantum;   // 0 unless the algorithm uses one
+
+    bool operator==(const ResultCacheKey& o) const {
+        return workload_hash == o.workload_hash && n == o.n && algo == o.algo && quantum == o.quantum;
+    }
+};
+
+ResultCacheKey make_cache_key(const WorkloadHash& w, AlgoId algo, int quantum);
+
+// Content-addressed AlgoResult store backed by one append-only file. The
+// whole file is indexed in memory on open; new results are appended as
+// fixed-size records with a check value, so a crash can at worst lose the
+// last record: open() cuts a torn tail off before anything is appended, and
+// records that fail their check are skipped.
+class ResultCache {
+public:
+    ResultCache();
+
+    // Loads (or creates) the cache file; returns false if it is unusable
+    bool open(const std::string& path);
+    bool is_open() const { return !path_.empty(); }
+
+    // switches receives the run's context-switch count, or -1 when the run
+    // that stored it did not count them (the calculate_* engines)
+    bool lookup(const ResultCacheKey& key, AlgoResult& out, long long* switches = 0) const;
+    void store(const ResultCacheKey& key, const AlgoResult& result, long long switches = -1);
+
+    std::size_t size() const { return entries_.size(); }
+    std::size_t hits() const { return hits_; }
+
+private:
+    struct Entry {
+        double avg_tat;
+        double avg_wt;
+        long long min_tat, max_tat, min_wt, max_wt;
+        long long switches;
+    };
+    struct KeyHash {
+        std::size_t operator()(const ResultCacheKey& k) const {
+            return (std::size_t)(k.workload_hash ^ (k.n * 0x9E3779B97F4A7C15ULL) ^
+                                 ((std::uint64_t)k.algo << 40) ^ (std::uint64_t)(std::uint32_t)k.quantum);
+        }
+    };
+
+    std::string path_;
+    bool writable_;         // False when a torn tail could not be cut off
+    std::unordered_map<ResultCacheKey, Entry, KeyHash> entries_;
+    mutable std::size_t hits_;
+};
+
+// Process-wide cache at $SIM_RESULT_CACHE (default "scheduler_results.cache";
+// SIM_RESULT_CACHE=0 turns caching off). Null when disabled or unusable.
+ResultCache* default_result_cache();
+
+// Looks the run up before calling `engine`, and stores fresh results
+template <typename Engine>
+AlgoResult cached_result(ResultCache* cache, const WorkloadHash& w, AlgoId algo, int quantum, Engine engine) {
+    if (!cache) return engine();
+    ResultCacheKey key = make_cache_key(w, algo, quantum);
+    AlgoResult r;
+    if (cache->lookup(key, r)) return r;
+    r = engine();
+    cache->store(key, r);
+    return r;
+}
+
+#endif // RESULT_CACHE_HPP
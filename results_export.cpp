@@ -0,0 +1,210 @@
+#include "results_export.hpp"
+#include "workload_io.hpp"
+#include "arrival_order.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+struct ColumnSpec {
+    uint32_t width;
+    const char* name;
+};
+
+const ColumnSpec RESULT_COLUMNS[] = {
+    {4, "pid"}, {8, "at"}, {8, "bt"}, {8, "ct"}, {8, "tat"}, {8, "wt"}, {8, "rt"}
+};
+const uint32_t RESULT_COLUMN_COUNT = sizeof(RESULT_COLUMNS) / sizeof(RESULT_COLUMNS[0]);
+
+template <typename T>
+bool write_column(FILE* f, const vector<T>& v) {
+    return v.empty() || fwrite(&v[0], sizeof(T), v.size(), f) == v.size();
+}
+
+} // namespace
+
+ProcessResultWriter::ProcessResultWriter(const vector<Proc>& procs, FILE* csv, FILE* columnar)
+    : procs_(procs), columnar_(columnar), columnar_failed_(false),
+      algo_(ALGO_FCFS), quantum_(0), rows_(0) {
+    if (csv) {
+        csv_.reset(new BufferedWriter(csv));
+        csv_->write("algorithm,pid,at,bt,ct,tat,wt,rt\n");
+    }
+    if (columnar_) {
+        uint32_t version = RESULT_COLUMNAR_VERSION;
+        uint32_t count = RESULT_COLUMN_COUNT;
+        bool ok = fwrite("SCHEDCL1", 1, 8, columnar_) == 8 &&
+                  fwrite(&version, sizeof(version), 1, columnar_) == 1 &&
+                  fwrite(&count, sizeof(count), 1, columnar_) == 1;
+        for (uint32_t c = 0; c < count && ok; ++c) {
+            ok = fwrite(&RESULT_COLUMNS[c].width, sizeof(uint32_t), 1, columnar_) == 1 &&
+                 fputs(RESULT_COLUMNS[c].name, columnar_) >= 0 && fputc('\0', columnar_) != EOF;
+        }
+        if (!ok) columnar_failed_ = true;
+    }
+}
+
+void ProcessResultWriter::begin_algorithm(AlgoId algo, int quantum) {
+    flush_group();
+    algo_ = algo;
+    quantum_ = algo == ALGO_RR ? quantum : 0;
+    algo_name_ = algo_display_name(algo, quantum);
+    first_run_.assign(procs_.size(), -1);
+}
+
+void ProcessResultWriter::on_run(int, int idx, long long start, long long) {
+    if (first_run_[idx] < 0) first_run_[idx] = start;
+}
+
+void ProcessResultWriter::on_complete(int, int idx, long long t, long long wt) {
+    const Proc& p = procs_[idx];
+    long long tat = t - p.at;
+    long long rt = first_run_[idx] < 0 ? 0 : first_run_[idx] - p.at;
+    rows_++;
+
+    if (csv_) {
+        BufferedWriter& out = *csv_;
+        out.write(algo_name_);
+        out.put(',');
+        out.write_int(p.no);
+        out.put(',');
+        out.write_int(p.at);
+        out.put(',');
+        out.write_int(p.bt);
+        out.put(',');
+        out.write_int(t);
+        out.put(',');
+        out.write_int(tat);
+        out.put(',');
+        out.write_int(wt);
+        out.put(',');
+        out.write_int(rt);
+        out.put('\n');
+    }
+    if (columnar_) {
+        pid_.push_back(p.no);
+        at_.push_back(p.at);
+        bt_.push_back(p.bt);
+        ct_.push_back(t);
+        tat_.push_back(tat);
+        wt_.push_back(wt);
+        rt_.push_back(rt);
+        if (pid_.size() == RESULT_GROUP_ROWS) flush_group();
+    }
+}
+
+void ProcessResultWriter::flush_group() {
+    if (!columnar_ || pid_.empty()) return;
+    uint32_t header[3] = {(uint32_t)algo_, (uint32_t)quantum_, (uint32_t)pid_.size()};
+    bool ok = fwrite(header, sizeof(uint32_t), 3, columnar_) == 3 &&
+              write_column(columnar_, pid_) && write_column(columnar_, at_) &&
+              write_column(columnar_, bt_) && write_column(columnar_, ct_) &&
+              write_column(columnar_, tat_) && write_column(columnar_, wt_) &&
+              write_column(columnar_, rt_);
+    if (!ok) columnar_failed_ = true;
+    pid_.clear();
+    at_.clear();
+    bt_.clear();
+    ct_.clear();
+    tat_.clear();
+    wt_.clear();
+    rt_.clear();
+}
+
+bool ProcessResultWriter::close() {
+    flush_group();
+    bool ok = !columnar_failed_;
+    if (columnar_ && fflush(columnar_) != 0) ok = false;
+    if (csv_) {
+        csv_->flush();
+        if (csv_->failed()) ok = false;
+    }
+    return ok;
+}
+
+bool export_process_results(const vector<Proc>& procs, const vector<AlgoId>& algos, int quantum,
+                            const string& csv_path, const string& columnar_path,
+                            string& error, long long* rows) {
+    FILE* csv = 0;
+    FILE* columnar = 0;
+    if (!csv_path.empty() && !(csv = fopen(csv_path.c_str(), "wb"))) {
+        error = "cannot create " + csv_path;
+        return false;
+    }
+    if (!columnar_path.empty() && !(columnar = fopen(columnar_path.c_str(), "wb"))) {
+        if (csv) fclose(csv);
+        error = "cannot create " + columnar_path;
+        return false;
+    }
+
+    // StreamEngine takes arrivals in (at, index) order
+    vector<int> order = arrival_order(procs);
+
+    bool ok;
+    {
+        ProcessResultWriter writer(procs, csv, columnar);
+        for (size_t a = 0; a < algos.size(); ++a) {
+            writer.begin_algorithm(algos[a], quantum);
+            StreamEngine engine(algos[a], quantum);
+            engine.set_observer(&writer);
+            for (size_t i = 0; i < order.size(); ++i) engine.feed(procs[order[i]], order[i]);
+            engine.finish();
+        }
+        ok = writer.close();
+        if (rows) *rows = writer.rows_written();
+    }
+    if (csv && fclose(csv) != 0) ok = false;
+    if (columnar && fclose(columnar) != 0) ok = false;
+    if (!ok) error = "write failed";
+    return ok;
+}
+
+// --- MENU ENTRY ---
+void run_results_export() {
+    cout << "\n<-- Per-Process Results Export Selected -->" << endl;
+    vector<Proc> procs;
+    if (!prompt_workload(procs)) {
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "\nPress Enter to return to main menu...";
+        cin.get();
+        return;
+    }
+
+    int quantum;
+    cout << "Enter Time Quantum (Q) for Round Robin: ";
+    if (!(cin >> quantum) || quantum <= 0) {
+        cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        quantum = 2;
+    }
+
+    string csv_path, columnar_path;
+    cout << "CSV file ('-' to skip): ";
+    cin >> csv_path;
+    cout << "Columnar binary file ('-' to skip): ";
+    cin >> columnar_path;
+    if (csv_path == "-") csv_path.clear();
+    if (columnar_path == "-") columnar_path.clear();
+
+    vector<AlgoId> algos;
+    for (int a = 0; a < ALGO_COUNT; ++a) algos.push_back((AlgoId)a);
+
+    string error;
+    long long rows = 0;
+    if (csv_path.empty() && columnar_path.empty()) {
+        cout << "\nNothing to write." << endl;
+    } else if (export_process_results(procs, algos, quantum, csv_path, columnar_path, error, &rows)) {
+        cout << "\nWrote " << rows << " rows (" << procs.size() << " processes x " << algos.size()
+             << " algorithms)." << endl;
+    } else {
+        cout << "\nResults export failed: " << error << endl;
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
@@ -0,0 +1,74 @@
+#ifndef RESULTS_EXPORT_HPP
+#define RESULTS_EXPORT_HPP
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "scheduler_common.hpp"
+#include "stream_engine.hpp"
+#include "trace_export.hpp"
+
+// Columnar file layout (native byte order, so read it on a machine of the
+// same endianness; little-endian on x86 and ARM):
+//   header    "SCHEDCL1", uint32 version, uint32 column count,
+//             then per column: uint32 width in bytes, NUL-terminated name
+//   row group uint32 algorithm (AlgoId), uint32 quantum, uint32 rows,
+//             then every column as `rows` consecutive values
+// Row groups hold one algorithm each and at most RESULT_GROUP_ROWS rows.
+const unsigned RESULT_COLUMNAR_VERSION = 1;
+const unsigned RESULT_GROUP_ROWS = 65536;
+
+// Writes one row per completed job (pid, at, bt, ct, tat, wt, response time)
+// as the engine reports it, to a CSV file, a columnar file, or both. Jobs an
+// engine never schedules (SRTF/RR with bt <= 0) get no row.
+class ProcessResultWriter : public ScheduleObserver {
+public:
+    // Either file may be null. procs must outlive the writer.
+    ProcessResultWriter(const std::vector<Proc>& procs, std::FILE* csv, std::FILE* columnar);
+
+    // Rows written after this belong to `algo`
+    void begin_algorithm(AlgoId algo, int quantum);
+
+    void on_arrival(int, long long) {}
+    void on_run(int cpu, int idx, long long start, long long end);
+    void on_preempt(int, int, long long, PreemptReason) {}
+    void on_complete(int cpu, int idx, long long t, long long wt);
+
+    // Writes the pending row group and flushes both files
+    bool close();
+
+    long long rows_written() const { return rows_; }
+
+private:
+    void flush_group();
+
+    const std::vector<Proc>& procs_;
+    std::unique_ptr<BufferedWriter> csv_;
+    std::FILE* columnar_;
+    bool columnar_failed_;
+
+    AlgoId algo_;
+    int quantum_;
+    std::string algo_name_;
+    std::vector<long long> first_run_;   // Per job, -1 until it first gets the CPU
+    long long rows_;
+
+    // Current row group, one vector per column
+    std::vector<int> pid_;
+    std::vector<long long> at_, bt_, ct_, tat_, wt_, rt_;
+
+    ProcessResultWriter(const ProcessResultWriter&);
+    ProcessResultWriter& operator=(const ProcessResultWriter&);
+};
+
+// Runs every algorithm in `algos` over the workload through a StreamEngine and
+// streams the per-process results. Either path may be empty.
+bool export_process_results(const std::vector<Proc>& procs, const std::vector<AlgoId>& algos, int quantum,
+                            const std::string& csv_path, const std::string& columnar_path,
+                            std::string& error, long long* rows = 0);
+
+// Menu entry
+void run_results_export();
+
+#endif // RESULTS_EXPORT_HPP
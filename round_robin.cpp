@@ -1,12 +1,16 @@
 #include "round_robin.hpp"
+#include "perf_counters.hpp"
+#include "sim_viewport.hpp"
+#include "live_view.hpp"
 #include <algorithm>
 #include <thread>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
 #include <limits>
-#include <queue>
+#include <deque>
 #include <map>  
+#include <memory>
 using namespace std;
 
 struct RRProcessData {
@@ -21,18 +25,18 @@ struct RRProcessData {
 
 vector<RRProcessData> rr_processes;
 
-// Simulation Display Logic
-void printSimulation_rr(const vector<Proc>& p_display, int n, int current_time, int quantum, int running_id) {
+// Simulation Display Logic (view maps a process number to its rr_processes slot)
+void printSimulation_rr(const vector<Proc>& p_display, int n, int current_time, int quantum, int running_id,
+                        const SimViewport& view) {
     clearScreen();
     
     cout << "=== Round Robin (RR) Scheduling Simulation ===" << endl;
     cout << "Time Quantum (Q): " << quantum << "s | Current Global Time: " << current_time << " seconds" << endl;
     
     for(int i = 0; i < n; ++i) {
-        auto it = find_if(rr_processes.begin(), rr_processes.end(), 
-                          [&](const RRProcessData& p) { return p.id == p_display[i].no; });
-
-        if (it == rr_processes.end()) continue;
+        int slot = view.slot_of(p_display[i].no);
+        if (slot < 0) continue;
+        auto it = rr_processes.begin() + slot;
 
         int current_rt = it->remaining_time;
         int total_bt = it->burst_time;
@@ -74,6 +78,26 @@ void printSimulation_rr(const vector<Proc>& p_display, int n, int current_time,
     }
 }
 
+// One frame: the full listing for small workloads, the viewport otherwise
+static void show_frame_rr(SimViewport& view, const vector<Proc>& p_display, int n, int current_time, int quantum,
+                          int running_id, const deque<int>& ready_queue) {
+    if (!view.active()) {
+        printSimulation_rr(p_display, n, current_time, quantum, running_id, view);
+        return;
+    }
+    view.set_time(current_time);
+    view.set_running(running_id);
+    if (running_id >= 0) {
+        const RRProcessData& r = rr_processes[view.slot_of(running_id)];
+        int executed = r.burst_time - r.remaining_time;
+        view.set_progress(running_id, r.burst_time == 0 ? 100 : (int)((double)executed * 100.0 / r.burst_time));
+    }
+    view.clear_ready();
+    for (int k = 0; k < (int)ready_queue.size() && k < view.rows(); ++k) {
+        view.offer_ready(rr_processes[ready_queue[k]].id, k);
+    }
+    view.render("Round Robin (RR) Scheduling Simulation, Q=" + to_string(quantum) + "s");
+}
 
 // Main Round Robin Scheduling Logic
 void run_round_robin_simulation() {
@@ -109,6 +133,8 @@ void run_round_robin_simulation() {
     new_rr_proc.remaining_time = proc_data.bt;
     rr_processes.push_back(new_rr_proc);
 }
+    if (run_visual_mode_live(p, ALGO_RR, quantum)) return;
+    SimViewport view(p);   // Built in input order, so its slots index rr_processes
     
  
     sort(p.begin(), p.end(), compareByAT);
@@ -119,15 +145,22 @@ void run_round_robin_simulation() {
     int current_time = 0;
     int completed_count = 0;
     
-    queue<int> ready_queue; 
+    deque<int> ready_queue; 
     
     map<int, bool> in_queue; 
 
+    // Optional hardware counters (SIM_PERF=1); frames and pacing sleeps are excluded
+    unique_ptr<PerfCounters> counters;
+    if (perf_profiling_enabled()) {
+        counters.reset(new PerfCounters());
+        counters->start();
+    }
+
     while (completed_count < n) {
         
         for (int i = 0; i < n; ++i) {
             if (rr_processes[i].arrival_time <= current_time && !in_queue[rr_processes[i].id] && rr_processes[i].remaining_time > 0) {
-                ready_queue.push(i); 
+                ready_queue.push_back(i); 
                 in_queue[rr_processes[i].id] = true;
             }
         }
@@ -137,7 +170,7 @@ void run_round_robin_simulation() {
 
         if (!ready_queue.empty()) {
             running_index = ready_queue.front(); 
-            ready_queue.pop();
+            ready_queue.pop_front();
             running_id = rr_processes[running_index].id;
             
             in_queue[running_id] = false; 
@@ -159,9 +192,11 @@ void run_round_robin_simulation() {
             if (processes_waiting && next_arrival_time != numeric_limits<int>::max()) {
                  int idle_duration = next_arrival_time - current_time;
                  
-                 printSimulation_rr(p, n, current_time, quantum, running_id);
+                 if (counters) counters->pause();
+                 show_frame_rr(view, p, n, current_time, quantum, running_id, ready_queue);
                  cout << "\nCPU is IDLE for " << idle_duration << "s (T=" << current_time << " to T=" << next_arrival_time << ").\n";
                  this_thread::sleep_for(chrono::seconds(2)); 
+                 if (counters) counters->resume();
                  
                  current_time = next_arrival_time;
                  continue; 
@@ -173,7 +208,9 @@ void run_round_robin_simulation() {
         int run_time = min(rr_processes[running_index].remaining_time, quantum);
         int execution_start_time = current_time;
         
-        printSimulation_rr(p, n, current_time, quantum, running_id);
+        if (counters) counters->pause();
+        show_frame_rr(view, p, n, current_time, quantum, running_id, ready_queue);
+        if (counters) counters->resume();
 
         for(int t = 0; t < run_time; ++t) {
             
@@ -189,13 +226,15 @@ void run_round_robin_simulation() {
             // Check for new arrivals every second and add to queue
             for (int i = 0; i < n; ++i) {
                 if (rr_processes[i].arrival_time == current_time && !in_queue[rr_processes[i].id] && rr_processes[i].remaining_time > 0) {
-                    ready_queue.push(i);
+                    ready_queue.push_back(i);
                     in_queue[rr_processes[i].id] = true;
                 }
             }
 
-            printSimulation_rr(p, n, current_time, quantum, running_id);
+            if (counters) counters->pause();
+            show_frame_rr(view, p, n, current_time, quantum, running_id, ready_queue);
             this_thread::sleep_for(chrono::seconds(1));
+            if (counters) counters->resume();
         }
 
         
@@ -203,19 +242,24 @@ void run_round_robin_simulation() {
             rr_processes[running_index].completion_time = current_time;
             rr_processes[running_index].turn_around_time = rr_processes[running_index].completion_time - rr_processes[running_index].arrival_time;
             completed_count++;
+            view.complete(running_id, current_time);
 
-            printSimulation_rr(p, n, current_time, quantum, -1); // -1 means no process is running
+            if (counters) counters->pause();
+            show_frame_rr(view, p, n, current_time, quantum, -1, ready_queue); // -1 means no process is running
             cout << "\nProcess P" << running_id << " COMPLETED at T=" << current_time << ".\n";
             this_thread::sleep_for(chrono::seconds(1)); 
+            if (counters) counters->resume();
             
         } else {
             
-            ready_queue.push(running_index); 
+            ready_queue.push_back(running_index); 
             in_queue[running_id] = true; 
             
-            printSimulation_rr(p, n, current_time, quantum, -1);
+            if (counters) counters->pause();
+            show_frame_rr(view, p, n, current_time, quantum, -1, ready_queue);
             cout << "\nProcess P" << running_id << " preempted. Quantum expired at T=" << current_time << ".\n";
             this_thread::sleep_for(chrono::seconds(1));
+            if (counters) counters->resume();
         }
     }
 
@@ -238,6 +282,8 @@ void run_round_robin_simulation() {
 
     avgtat /= n;
     avgwt /= n;
+    PerfSample perf_sample = PerfSample();
+    if (counters) perf_sample = counters->stop();
 
     clearScreen();
     cout << "\n=== Round Robin Simulation Complete ===" << endl;
@@ -259,6 +305,11 @@ void run_round_robin_simulation() {
     cout << "\n\033[1;35mAverage Turnaround Time =\033[0m " << avgtat << " seconds" << endl;
     cout << "\033[1;35mAverage Waiting Time =\033[0m " << avgwt << " seconds" << endl;
 
+    if (counters) {
+        print_perf_table(vector<string>(1, "RR (Q=" + to_string(quantum) + ")"), vector<PerfSample>(1, perf_sample),
+                         counters->unavailable_reason());
+    }
+
     cout << "\n--- Round Robin Simulation Finished ---\n" << endl;
     
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
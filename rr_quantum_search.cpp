@@ -0,0 +1,355 @@
+#include "rr_quantum_search.hpp"
+#include "workload_io.hpp"
+#include "arrival_order.hpp"
+#include "order_statistic.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+// --- RR EVALUATOR ---
+RRQuantumEvaluator::RRQuantumEvaluator(const vector<Proc>& procs) : n_((int)procs.size()), max_bt_(0) {
+    vector<int> order = arrival_order(procs);
+    at_.reserve(order.size());
+    bt_.reserve(order.size());
+    for (int i : order) {
+        if (procs[i].bt <= 0) continue;   // Zero-length jobs never enter the queue
+        at_.push_back(procs[i].at);
+        bt_.push_back(procs[i].bt);
+        max_bt_ = max(max_bt_, procs[i].bt);
+    }
+}
+
+static double objective_value(const QuantumEval& e, QuantumObjective objective, double switch_cost, int n) {
+    switch (objective) {
+        case OBJ_AVG_WT:  return e.avg_wt;
+        case OBJ_AVG_TAT: return e.avg_tat;
+        case OBJ_P99_TAT: return (double)e.p99_tat;
+        case OBJ_WEIGHTED:
+        default:
+            return (e.avg_wt + e.avg_tat) / 2.0 + switch_cost * (double)e.context_switches / n;
+    }
+}
+
+namespace {
+
+// Slice policies for RRQuantumEvaluator::run. enqueue() sees every job that
+// joins the ready queue, dispatch() the job leaving it and returns its slice.
+struct FixedSlices {
+    long long quantum;
+    void enqueue(int, long long) {}
+    long long dispatch(int, long long) { return quantum; }
+};
+
+struct PercentileSlices {
+    OrderStatisticTree remaining;   // Remaining times of the queued jobs
+    int percentile;
+
+    PercentileSlices(ScratchArena& scratch, int jobs, int p) : remaining(scratch, jobs), percentile(p) {}
+
+    void enqueue(int j, long long rem) { remaining.insert(j, rem); }
+    long long dispatch(int j, long long) {
+        long long rank = ((long long)remaining.size() * percentile + 99) / 100 - 1;
+        long long quantum = remaining.kth((int)max(0LL, rank));
+        remaining.erase(j);
+        return max(1LL, quantum);
+    }
+};
+
+// RR over the runnable jobs at[0..m) / bt[0..m) in arrival order, out of n
+// jobs in total (the other n - m never run and count as 0)
+template <typename Slices>
+QuantumEval run_rr(const int* at, const int* bt, int m, int n, Slices& slices, QuantumEval e,
+                   QuantumObjective objective, double switch_cost, ScratchArena& scratch) {
+    long long* rem = scratch.alloc_array<long long>(m);
+    long long* tat = scratch.alloc_array<long long>(n);  // Jobs that never run stay 0
+    int* queue = scratch.alloc_array<int>(m > 0 ? m : 1); // Ring buffer; a job is queued at most once
+    fill(tat, tat + n, 0LL);
+    for (int i = 0; i < m; ++i) rem[i] = bt[i];
+
+    int head = 0, size = 0, next = 0, last = -1;
+    long long t = 0, sum_tat = 0, sum_bt = 0, switches = 0;
+    const long long lo = numeric_limits<long long>::min(), hi = numeric_limits<long long>::max();
+    long long min_tat = hi, max_tat = lo, min_wt = hi, max_wt = lo;
+    auto enqueue = [&](int j) {
+        queue[(head + size++) % m] = j;
+        slices.enqueue(j, rem[j]);
+    };
+    while (next < m || size > 0) {
+        if (size == 0 && t < at[next]) t = at[next];  // Idle CPU
+        while (next < m && at[next] <= t) enqueue(next++);
+
+        int j = queue[head];
+        head = (head + 1) % m;
+        size--;
+        if (j != last) switches++;
+        last = j;
+
+        long long run = min(rem[j], slices.dispatch(j, rem[j]));
+        t += run;
+        rem[j] -= run;
+
+        // Arrivals during the slice (and at its end) go ahead of the preempted job
+        while (next < m && at[next] <= t) enqueue(next++);
+        if (rem[j] == 0) {
+            tat[j] = t - at[j];
+            sum_tat += tat[j];
+            sum_bt += bt[j];
+            min_tat = min(min_tat, tat[j]);
+            max_tat = max(max_tat, tat[j]);
+            min_wt = min(min_wt, tat[j] - bt[j]);
+            max_wt = max(max_wt, tat[j] - bt[j]);
+        } else {
+            enqueue(j);
+        }
+    }
+    if (m < n) {   // Zero-length jobs
+        min_tat = min(min_tat, 0LL);
+        max_tat = max(max_tat, 0LL);
+        min_wt = min(min_wt, 0LL);
+        max_wt = max(max_wt, 0LL);
+    }
+
+    long long rank = (long long)ceil(0.99 * n) - 1;
+    if (rank < 0) rank = 0;
+    nth_element(tat, tat + rank, tat + n);
+
+    e.avg_tat = (double)sum_tat / n;
+    e.avg_wt = (double)(sum_tat - sum_bt) / n;
+    e.p99_tat = tat[rank];
+    e.min_tat = min_tat;
+    e.max_tat = max_tat;
+    e.min_wt = min_wt;
+    e.max_wt = max_wt;
+    e.context_switches = switches;
+    e.objective = objective_value(e, objective, switch_cost, n);
+    return e;
+}
+
+} // namespace
+
+QuantumEval RRQuantumEvaluator::evaluate(int quantum, QuantumObjective objective, double switch_cost,
+                                         EngineContext& ctx) const {
+    QuantumEval e = {quantum, 0.0, 0.0, 0, 0, 0.0, 0, 0, 0, 0, 0};
+    if (n_ == 0 || quantum <= 0) return e;
+    FixedSlices slices = {quantum};
+    return run_rr(at_.data(), bt_.data(), (int)at_.size(), n_, slices, e, objective, switch_cost,
+                  ctx.begin_run());
+}
+
+QuantumEval RRQuantumEvaluator::evaluate_adaptive(int percentile, QuantumObjective objective, double switch_cost,
+                                                  EngineContext& ctx) const {
+    return evaluate_rr_adaptive(at_.data(), bt_.data(), (int)at_.size(), n_, percentile, objective,
+                                switch_cost, ctx.begin_run());
+}
+
+QuantumEval evaluate_rr_adaptive(const int* at, const int* bt, int runnable, int n, int percentile,
+                                 QuantumObjective objective, double switch_cost, ScratchArena& scratch) {
+    percentile = min(100, max(1, percentile));
+    QuantumEval e = {0, 0.0, 0.0, 0, 0, 0.0, percentile, 0, 0, 0, 0};
+    if (n == 0) return e;
+    PercentileSlices slices(scratch, runnable, percentile);
+    return run_rr(at, bt, runnable, n, slices, e, objective, switch_cost, scratch);
+}
+
+// --- SEARCH ---
+namespace {
+
+bool better(const QuantumEval& a, const QuantumEval& b) {
+    if (a.objective != b.objective) return a.objective < b.objective;
+    if (a.context_switches != b.context_switches) return a.context_switches < b.context_switches;
+    return a.quantum < b.quantum;
+}
+
+// Memoised evaluation on the calling thread
+struct SearchState {
+    const RRQuantumEvaluator& eval;
+    QuantumObjective objective;
+    double switch_cost;
+    EngineContext ctx;
+    map<int, QuantumEval> seen;
+
+    SearchState(const RRQuantumEvaluator& e, QuantumObjective o, double c)
+        : eval(e), objective(o), switch_cost(c), ctx(e.size()) {}
+
+    const QuantumEval& at(int q) {
+        map<int, QuantumEval>::iterator it = seen.find(q);
+        if (it == seen.end()) it = seen.insert(make_pair(q, eval.evaluate(q, objective, switch_cost, ctx))).first;
+        return it->second;
+    }
+};
+
+} // namespace
+
+const char* objective_name(QuantumObjective objective) {
+    switch (objective) {
+        case OBJ_AVG_WT:  return "Avg WT";
+        case OBJ_AVG_TAT: return "Avg TAT";
+        case OBJ_P99_TAT: return "P99 TAT";
+        case OBJ_WEIGHTED:
+        default:          return "Weighted";
+    }
+}
+
+QuantumSearchResult find_best_quantum(const vector<Proc>& procs, QuantumObjective objective,
+                                      double switch_cost, int threads) {
+    RRQuantumEvaluator eval(procs);
+    SearchState state(eval, objective, switch_cost);
+    int hi_q = max(1, eval.max_burst());  // Beyond the longest burst RR no longer changes
+
+    // 1. Coarse grid, geometric so small quanta (where RR changes fastest) get more points
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    int grid_points = min(hi_q, max(16, 4 * threads));
+    vector<int> grid;
+    for (int g = 0; g < grid_points; ++g) {
+        double frac = grid_points == 1 ? 0.0 : (double)g / (grid_points - 1);
+        int q = (int)llround(exp(frac * log((double)hi_q)));
+        if (grid.empty() || q > grid.back()) grid.push_back(q);
+    }
+
+    vector<QuantumEval> grid_eval(grid.size());
+    atomic<size_t> next_point(0);
+    auto worker = [&]() {
+        EngineContext ctx(eval.size());  // Per-thread scratch
+        for (size_t g; (g = next_point.fetch_add(1)) < grid.size();) {
+            grid_eval[g] = eval.evaluate(grid[g], objective, switch_cost, ctx);
+        }
+    };
+    int spawn = min(threads, (int)grid.size()) - 1;
+    vector<thread> pool;
+    for (int i = 0; i < spawn; ++i) pool.push_back(thread(worker));
+    worker();
+    for (size_t i = 0; i < pool.size(); ++i) pool[i].join();
+
+    size_t best_g = 0;
+    for (size_t g = 0; g < grid.size(); ++g) {
+        state.seen[grid[g]] = grid_eval[g];
+        if (better(grid_eval[g], grid_eval[best_g])) best_g = g;
+    }
+
+    // 2. Integer ternary search between the neighbours of the best grid point
+    int lo = best_g > 0 ? grid[best_g - 1] : grid[best_g];
+    int hi = best_g + 1 < grid.size() ? grid[best_g + 1] : grid[best_g];
+    while (hi - lo > 8) {
+        int m1 = lo + (hi - lo) / 3;
+        int m2 = hi - (hi - lo) / 3;
+        double f1 = state.at(m1).objective;
+        double f2 = state.at(m2).objective;
+        if (f1 < f2) {
+            hi = m2;
+        } else if (f2 < f1) {
+            lo = m1;
+        } else {
+            // Plateau guard: equal probes say nothing about the slope
+            double fm = state.at(m1 + (m2 - m1) / 2).objective;
+            if (fm <= f1) {
+                lo = m1;
+                hi = m2;
+            } else {
+                break;  // Bump between the probes: not unimodal here, scan what is left
+            }
+        }
+    }
+
+    // 3. Finish the bracket exhaustively once it is narrow
+    if (hi - lo <= 64) {
+        for (int q = lo; q <= hi; ++q) state.at(q);
+    }
+
+    QuantumSearchResult result;
+    result.search_max = hi_q;
+    for (map<int, QuantumEval>::const_iterator it = state.seen.begin(); it != state.seen.end(); ++it) {
+        result.curve.push_back(it->second);
+    }
+    result.best = result.curve.front();
+    for (size_t i = 1; i < result.curve.size(); ++i) {
+        if (better(result.curve[i], result.best)) result.best = result.curve[i];
+    }
+    return result;
+}
+
+// --- MENU ENTRY ---
+void run_quantum_search() {
+    cout << "\n<-- Round Robin Quantum Optimizer Selected -->" << endl;
+    vector<Proc> procs;
+    if (!prompt_workload(procs)) {
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "\nPress Enter to return to main menu...";
+        cin.get();
+        return;
+    }
+
+    int choice;
+    cout << "Objective (1=Avg WT, 2=Avg TAT, 3=P99 TAT, 4=Weighted with context-switch cost): ";
+    if (!(cin >> choice) || choice < 1 || choice > 4) {
+        cout << "Invalid objective. Using Avg WT." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        choice = 1;
+    }
+    QuantumObjective objective = (QuantumObjective)(choice - 1);
+
+    double switch_cost = 0.0;
+    if (objective == OBJ_WEIGHTED) {
+        cout << "Cost of one context switch (seconds): ";
+        if (!(cin >> switch_cost) || switch_cost < 0) {
+            cout << "Invalid cost. Using 0.1 s." << endl;
+            cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            switch_cost = 0.1;
+        }
+    }
+
+    QuantumSearchResult r = find_best_quantum(procs, objective, switch_cost);
+    EngineContext ctx(procs.size());
+    QuantumEval adaptive = RRQuantumEvaluator(procs).evaluate_adaptive(ADAPTIVE_RR_PERCENTILE, objective,
+                                                                       switch_cost, ctx);
+
+    clearScreen();
+    cout << "\n========================================================" << endl;
+    cout << "|| ROUND ROBIN QUANTUM SEARCH (" << objective_name(objective) << ") ||" << endl;
+    cout << "========================================================" << endl;
+    cout << fixed << setprecision(2);
+
+    cout << left << setw(8) << "| Q"
+         << right << setw(14) << "| Avg TAT (s)"
+         << right << setw(14) << "| Avg WT (s)"
+         << right << setw(12) << "| P99 TAT"
+         << right << setw(12) << "| Switches"
+         << right << setw(14) << "| Objective |" << endl;
+    cout << "--------------------------------------------------------------------------" << endl;
+    for (const auto& e : r.curve) {
+        bool is_best = e.quantum == r.best.quantum;
+        cout << (is_best ? "\033[1;32m" : "")
+             << "| " << left << setw(6) << e.quantum
+             << right << setw(14) << e.avg_tat
+             << right << setw(14) << e.avg_wt
+             << right << setw(12) << e.p99_tat
+             << right << setw(12) << e.context_switches
+             << right << setw(12) << e.objective << " |"
+             << (is_best ? "\033[0m" : "") << endl;
+    }
+    cout << "--------------------------------------------------------------------------" << endl;
+    // Baseline with no tuning: Q follows the remaining times in the ready queue
+    cout << "| " << left << setw(6) << ("P" + to_string(adaptive.percentile))
+         << right << setw(14) << adaptive.avg_tat
+         << right << setw(14) << adaptive.avg_wt
+         << right << setw(12) << adaptive.p99_tat
+         << right << setw(12) << adaptive.context_switches
+         << right << setw(12) << adaptive.objective << " |" << endl;
+    cout << "--------------------------------------------------------------------------" << endl;
+    cout << "P" << adaptive.percentile << ": adaptive RR baseline (each Q = P" << adaptive.percentile
+         << " of the remaining times in the ready queue); "
+         << (r.best.objective < adaptive.objective ? "the best fixed Q beats it." : "no fixed Q beats it.") << endl;
+    cout << "Best quantum: Q=" << r.best.quantum << "  (" << r.curve.size() << " RR evaluations instead of "
+         << r.search_max << " for a full sweep of Q=1.." << r.search_max << ")" << endl;
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
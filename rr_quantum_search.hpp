@@ -0,0 +1,86 @@
+#ifndef RR_QUANTUM_SEARCH_HPP
+#define RR_QUANTUM_SEARCH_HPP
+
+#include <vector>
+#include "scheduler_common.hpp"
+#include "engine_context.hpp"
+
+enum QuantumObjective {
+    OBJ_AVG_WT,
+    OBJ_AVG_TAT,
+    OBJ_P99_TAT,
+    OBJ_WEIGHTED    // (avg WT + avg TAT) / 2 + switch_cost * context switches per process
+};
+
+// Round Robin metrics for one quantum
+struct QuantumEval {
+    int quantum;                  // 0 for the adaptive policy
+    double avg_tat;
+    double avg_wt;
+    long long p99_tat;            // Nearest-rank 99th percentile
+    long long context_switches;   // Dispatches of a different job than the one before
+    double objective;
+    int percentile;               // Adaptive policy only: percentile that sets each slice
+    long long min_tat, max_tat, min_wt, max_wt;
+};
+
+// RR over one workload, sorted once and then evaluated for any number of
+// quanta. Same schedule as calculate_rr (arrivals during or at the end of a
+// slice queue ahead of the preempted job; jobs with bt <= 0 never run and
+// count as 0), but event-driven, so a run costs O(number of slices).
+class RRQuantumEvaluator {
+public:
+    explicit RRQuantumEvaluator(const std::vector<Proc>& procs);
+
+    // ctx provides the scratch; use one context per thread
+    QuantumEval evaluate(int quantum, QuantumObjective objective, double switch_cost,
+                         EngineContext& ctx) const;
+
+    // Adaptive RR: every dispatch gets a quantum equal to the given
+    // percentile (1..100, nearest rank) of the remaining times of the jobs in
+    // the ready queue, the dispatched one included, and at least 1. The
+    // remaining times are kept in an order-statistic tree, so a dispatch
+    // costs O(log n) instead of a pass over the queue.
+    QuantumEval evaluate_adaptive(int percentile, QuantumObjective objective, double switch_cost,
+                                  EngineContext& ctx) const;
+
+    int max_burst() const { return max_bt_; }
+    int size() const { return n_; }
+
+private:
+    int n_;                  // All jobs, including the ones that never run
+    int max_bt_;
+    std::vector<int> at_;    // Runnable jobs (bt > 0) in (at, index) order
+    std::vector<int> bt_;
+};
+
+// The adaptive policy on columns the caller already holds: at/bt of the
+// runnable jobs (bt > 0) in (at, index) order, out of n jobs in total. All
+// scratch comes from `scratch`, which is not reset, so the columns may live
+// in it too.
+QuantumEval evaluate_rr_adaptive(const int* at, const int* bt, int runnable, int n, int percentile,
+                                 QuantumObjective objective, double switch_cost, ScratchArena& scratch);
+
+struct QuantumSearchResult {
+    QuantumEval best;
+    std::vector<QuantumEval> curve;  // Every evaluated quantum, ascending
+    int search_max;                  // Upper end of the range (an exhaustive sweep's length)
+};
+
+// Coarse geometric grid over [1, max burst] evaluated in parallel, then an
+// integer ternary search around the best grid point. Plateaus (equal values
+// at both probes) are resolved with a midpoint probe, and narrow brackets are
+// finished by a linear scan. Ties prefer fewer context switches, then the
+// smaller quantum. threads <= 0 uses the hardware thread count.
+QuantumSearchResult find_best_quantum(const std::vector<Proc>& procs, QuantumObjective objective,
+                                      double switch_cost = 0.0, int threads = 0);
+
+const char* objective_name(QuantumObjective objective);
+
+// Default percentile of the adaptive RR baseline (the median)
+const int ADAPTIVE_RR_PERCENTILE = 50;
+
+// Menu entry: optimise Q for a workload and print the evaluated curve
+void run_quantum_search();
+
+#endif // RR_QUANTUM_SEARCH_HPP
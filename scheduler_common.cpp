@@ -7,6 +7,10 @@
     void clearScreen() {
         system("cls");
     }
+#else
+    void clearScreen() {
+        std::cout << "\033[2J\033[H" << std::flush; // ANSI clear + cursor home
+    }
 #endif
 
 // Input Function:
@@ -17,6 +21,8 @@ Proc read_proc(int i) {
     p.progress = 0; 
     p.ct = 0;      
     p.is_completed = false; // Initialized here for safety
+    p.job_class = 0;
+    p.working_set = 0;
     std::cout << "Enter Arrival Time (AT in seconds): ";
     std::cin >> p.at;
     std::cout << "Enter Burst Time (BT in seconds): ";
@@ -10,6 +10,8 @@ struct Proc {
     int at;          // Arrival Time
     int bt;          // Burst Time
     int priority;    // Priority
+    int job_class;   // Workload class / recurring process id for burst prediction (0 if unknown)
+    int working_set; // Working-set size in KB, for the migration cost on multi-core runs (0 if unknown)
     
     // Calculated Metrics
     int ct;          // Completion Time
@@ -0,0 +1,194 @@
+#include "sim_viewport.hpp"
+#include "arrival_order.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+SimViewport::SimViewport(const vector<Proc>& procs, ReadyOrder order, int rows)
+    : order_(order), with_priority_(order == READY_BY_PRIORITY), rows_(max(1, rows)), time_(0), arrived_(0),
+      completed_(0), recent_head_(0), running_(-1) {
+    int n = procs.size();
+    int max_no = 0;
+    for (int i = 0; i < n; ++i) {
+        no_.push_back(procs[i].no);
+        at_.push_back(procs[i].at);
+        bt_.push_back(procs[i].bt);
+        priority_.push_back(procs[i].priority);
+        max_no = max(max_no, procs[i].no);
+    }
+    progress_.assign(n, 0);
+    ct_.assign(n, -1);
+    slot_of_no_.assign(max_no + 1, -1);
+    for (int i = 0; i < n; ++i) {
+        if (procs[i].no >= 0) slot_of_no_[procs[i].no] = i;
+    }
+    by_arrival_ = arrival_order(procs);
+    recent_.assign(rows_, -1);
+    ready_.reserve(rows_ + 1);
+
+    key_.resize(n);
+    tie_.resize(n);
+    queued_.assign(n, 0);
+    for (int i = 0; i < n; ++i) {
+        switch (order_) {
+            case READY_BY_BURST:    key_[i] = bt_[i]; tie_[i] = at_[i]; break;
+            case READY_BY_PRIORITY: key_[i] = priority_[i]; tie_[i] = at_[i]; break;
+            default:                key_[i] = at_[i]; tie_[i] = i; break;
+        }
+    }
+}
+
+int SimViewport::slot_of(int no) const {
+    return no >= 0 && no < (int)slot_of_no_.size() ? slot_of_no_[no] : -1;
+}
+
+void SimViewport::enqueue(int slot) {
+    if (order_ == READY_FROM_MODE || queued_[slot] || ct_[slot] >= 0 || slot == running_) return;
+    ReadyEntry e = {key_[slot], tie_[slot], no_[slot]};
+    ready_set_.insert(e);
+    queued_[slot] = 1;
+}
+
+void SimViewport::dequeue(int slot) {
+    if (!queued_[slot]) return;
+    ReadyEntry e = {key_[slot], tie_[slot], no_[slot]};
+    ready_set_.erase(e);
+    queued_[slot] = 0;
+}
+
+void SimViewport::set_time(long long t) {
+    time_ = t;
+    while (arrived_ < (int)by_arrival_.size() && at_[by_arrival_[arrived_]] <= t) enqueue(by_arrival_[arrived_++]);
+}
+
+void SimViewport::set_running(int no) {
+    int slot = slot_of(no);
+    if (slot == running_) return;
+    int preempted = running_;
+    running_ = slot;
+    if (slot >= 0) dequeue(slot);
+    if (preempted >= 0 && at_[preempted] <= time_) enqueue(preempted);
+}
+
+void SimViewport::set_ready_key(int no, long long key, long long tie) {
+    int slot = slot_of(no);
+    if (slot < 0 || (key_[slot] == key && tie_[slot] == tie)) return;
+    bool queued = queued_[slot];
+    dequeue(slot);
+    key_[slot] = key;
+    tie_[slot] = tie;
+    if (queued) enqueue(slot);
+}
+
+void SimViewport::set_progress(int no, int percent) {
+    int slot = slot_of(no);
+    if (slot >= 0) progress_[slot] = min(100, max(0, percent));
+}
+
+void SimViewport::complete(int no, long long ct) {
+    int slot = slot_of(no);
+    if (slot < 0 || ct_[slot] >= 0) return;
+    ct_[slot] = ct;
+    progress_[slot] = 100;
+    ++completed_;
+    recent_[recent_head_] = slot;
+    recent_head_ = (recent_head_ + 1) % rows_;
+    if (slot == running_) running_ = -1;
+    dequeue(slot);
+}
+
+void SimViewport::clear_ready() {
+    ready_.clear();
+}
+
+void SimViewport::offer_ready(int no, long long key, long long tie) {
+    ReadyEntry e = {key, tie, no};
+    auto before = [](const ReadyEntry& a, const ReadyEntry& b) {
+        if (a.key != b.key) return a.key < b.key;
+        if (a.tie != b.tie) return a.tie < b.tie;
+        return a.no < b.no;
+    };
+    if ((int)ready_.size() == rows_ && !before(e, ready_.back())) return;
+    ready_.insert(upper_bound(ready_.begin(), ready_.end(), e, before), e);
+    if ((int)ready_.size() > rows_) ready_.pop_back();
+}
+
+void SimViewport::print_row(int slot, const char* indent) const {
+    const int total_bar_length = 50;
+    stringstream info;
+    info << "P" << no_[slot] << " (";
+    if (with_priority_) info << "Prio:" << priority_[slot] << " | ";
+    info << "AT:" << at_[slot] << " | BT:" << bt_[slot] << "s): ";
+    cout << indent << left << setw(35) << info.str();
+
+    int display_progress = progress_[slot] / 2;
+    cout << "[" << string(display_progress, '#') << string(total_bar_length - display_progress, ' ') << "] ";
+    cout << setw(3) << progress_[slot] << "%";
+
+    if (ct_[slot] >= 0) {
+        cout << " - \033[1;32mCOMPLETED\033[0m (CT: " << ct_[slot] << ")";
+    } else if (slot == running_) {
+        cout << " - \033[1;33mRUNNING\033[0m";
+    } else if (time_ < at_[slot]) {
+        cout << " - WAITING (Not Arrived)";
+    } else {
+        cout << " - WAITING (Ready Queue)";
+    }
+    cout << endl;
+}
+
+void SimViewport::render(const string& title) const {
+    clearScreen();
+    int n = at_.size();
+    int ready = arrived_ - completed_ - (running_ >= 0 ? 1 : 0);
+
+    cout << "=== " << title << " ===" << endl;
+    cout << "Current Global Time: " << time_ << " seconds" << endl;
+    cout << "Arrived: " << arrived_ << "/" << n << " | Ready: " << ready
+         << " | Completed: " << completed_ << "/" << n << " | CPU: ";
+    if (running_ >= 0) cout << "P" << no_[running_] << endl;
+    else cout << "IDLE" << endl;
+    cout << "---------------------------------" << endl;
+
+    cout << "Running:" << endl;
+    if (running_ >= 0) print_row(running_, "  ");
+    else cout << "  (none)" << endl;
+
+    cout << "Next in the ready queue:" << endl;
+    int listed = 0;
+    if (order_ == READY_FROM_MODE) {
+        for (size_t i = 0; i < ready_.size(); ++i, ++listed) print_row(slot_of(ready_[i].no), "  ");
+    } else {
+        for (set<ReadyEntry>::const_iterator it = ready_set_.begin(); it != ready_set_.end() && listed < rows_; ++it, ++listed) {
+            print_row(slot_of(it->no), "  ");
+        }
+    }
+    if (listed == 0) cout << "  (empty)" << endl;
+    if (ready > listed) cout << "  ... and " << ready - listed << " more" << endl;
+
+    cout << "Recently completed:" << endl;
+    if (completed_ == 0) cout << "  (none)" << endl;
+    for (int k = 1; k <= rows_; ++k) {
+        int slot = recent_[(recent_head_ - k + rows_) % rows_];
+        if (slot >= 0) print_row(slot, "  ");
+    }
+
+    // Window of consecutive process numbers around the running (or last finished) job
+    int center = running_ >= 0 ? running_ : recent_[(recent_head_ - 1 + rows_) % rows_];
+    int window = 2 * rows_;
+    int max_no = (int)slot_of_no_.size() - 1;
+    int first = center >= 0 ? no_[center] - rows_ : 1;
+    first = max(1, min(first, max_no - window + 1));
+    int shown = 0;
+    cout << "Processes from P" << first << ":" << endl;
+    for (int no = first; no <= max_no && shown < window; ++no) {
+        int slot = slot_of(no);
+        if (slot < 0) continue;
+        print_row(slot, "  ");
+        ++shown;
+    }
+    cout << "\n=================================\n";
+}
@@ -0,0 +1,87 @@
+#ifndef SIM_VIEWPORT_HPP
+#define SIM_VIEWPORT_HPP
+
+#include <set>
+#include <string>
+#include <vector>
+#include "scheduler_common.hpp"
+
+// Workloads up to this size keep the classic one-row-per-process frame
+const int VIEWPORT_LIST_ALL = 20;
+
+// How the "next in the ready queue" panel is ordered. READY_FROM_MODE: the
+// mode lists its own queue head with clear_ready/offer_ready before each
+// render. The others keep every ready job in a set ordered like the engine's
+// ready queue (arrival time, burst, or priority, then arrival time), which
+// the viewport updates itself on arrival, dispatch and completion.
+enum ReadyOrder { READY_FROM_MODE, READY_BY_ARRIVAL, READY_BY_BURST, READY_BY_PRIORITY };
+
+// Frame for the visual modes that stays readable with thousands of
+// processes: counters, the running job, the next few ready jobs, the latest
+// completions and a window of consecutive process numbers that follows the
+// running job. The mode reports what happens (each call O(log n), or O(rows)
+// for offer_ready) and processes are found through a Proc::no -> slot table
+// built once, so drawing a frame costs O(rows) whatever the process count.
+class SimViewport {
+public:
+    // procs in any order; READY_BY_PRIORITY also adds the priority to each row
+    SimViewport(const std::vector<Proc>& procs, ReadyOrder order = READY_FROM_MODE, int rows = 5);
+
+    // False for small workloads: the mode draws its full listing instead
+    bool active() const { return (int)at_.size() > VIEWPORT_LIST_ALL; }
+
+    int slot_of(int no) const;      // Position in the constructor's vector, -1 if unknown
+    int rows() const { return rows_; }
+
+    void set_time(long long t);     // Jobs arriving by t join the ready set
+    void set_running(int no);       // -1: CPU idle. A preempted job rejoins the ready set
+    void set_progress(int no, int percent);
+    void complete(int no, long long ct);
+
+    // Moves a job within the ready set: SRTF's remaining time, RR's requeue time
+    void set_ready_key(int no, long long key, long long tie);
+
+    // READY_FROM_MODE only: offer_ready keeps the `rows` candidates that
+    // dispatch first (smallest key, then tie, then number)
+    void clear_ready();
+    void offer_ready(int no, long long key, long long tie = 0);
+
+    void render(const std::string& title) const;
+
+private:
+    struct ReadyEntry {
+        long long key, tie;
+        int no;
+        bool operator<(const ReadyEntry& o) const {
+            if (key != o.key) return key < o.key;
+            if (tie != o.tie) return tie < o.tie;
+            return no < o.no;
+        }
+    };
+
+    void enqueue(int slot);
+    void dequeue(int slot);
+    void print_row(int slot, const char* indent) const;
+
+    std::vector<int> no_, at_, bt_, priority_;
+    std::vector<int> progress_;           // Percent done, per slot
+    std::vector<long long> ct_;           // -1 until completed
+    std::vector<int> slot_of_no_;
+    std::vector<int> by_arrival_;         // Slots in arrival order, for the arrived counter
+    std::vector<int> recent_;             // Ring of the latest completed slots
+    std::vector<ReadyEntry> ready_;       // READY_FROM_MODE: sorted, at most rows_
+    std::vector<long long> key_, tie_;    // Ready set order, per slot
+    std::vector<char> queued_;            // Slot is in ready_set_
+    std::set<ReadyEntry> ready_set_;      // Every ready job, unless READY_FROM_MODE
+
+    ReadyOrder order_;
+    bool with_priority_;
+    int rows_;
+    long long time_;
+    int arrived_;
+    int completed_;
+    int recent_head_;
+    int running_;                         // Slot, -1 when idle
+};
+
+#endif // SIM_VIEWPORT_HPP
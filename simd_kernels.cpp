@@ -0,0 +1,240 @@
+#include "simd_kernels.hpp"
+#include "simd_target.hpp"
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+static MetricSummary empty_summary() {
+    MetricSummary s = {0, 0, 0};
+    return s;
+}
+
+// --- Scalar reference versions ---
+FcfsKernelResult fcfs_kernel_scalar(const int* at, const int* bt, size_t n, long long* ct_out) {
+    FcfsKernelResult r = {empty_summary(), empty_summary()};
+    if (n == 0) return r;
+    r.tat.min = r.wt.min = numeric_limits<long long>::max();
+    r.tat.max = r.wt.max = numeric_limits<long long>::min();
+
+    long long current_time = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (current_time < at[i]) current_time = at[i];
+        current_time += bt[i];
+        if (ct_out) ct_out[i] = current_time;
+
+        long long tat = current_time - at[i];
+        long long wt = tat - bt[i];
+        r.tat.sum += tat;
+        r.wt.sum += wt;
+        r.tat.min = min(r.tat.min, tat);
+        r.tat.max = max(r.tat.max, tat);
+        r.wt.min = min(r.wt.min, wt);
+        r.wt.max = max(r.wt.max, wt);
+    }
+    return r;
+}
+
+MetricSummary reduce_metric_scalar(const int* values, size_t n) {
+    MetricSummary s = empty_summary();
+    if (n == 0) return s;
+    s.min = s.max = values[0];
+    for (size_t i = 0; i < n; ++i) {
+        s.sum += values[i];
+        if (values[i] < s.min) s.min = values[i];
+        if (values[i] > s.max) s.max = values[i];
+    }
+    return s;
+}
+
+#if SIMD_HAVE_AVX2_PATH
+
+// --- AVX2 versions (8 x int32 lanes, 64-bit accumulators) ---
+
+// [x0 .. x7] -> broadcast of x3 into the upper half, `low` in the lower half
+SIMD_AVX2 static inline __m256i carry_to_upper_half(__m256i x, __m256i low) {
+    __m256i up = _mm256_shuffle_epi32(_mm256_permute2x128_si256(x, x, 0x08), 0xFF);
+    return _mm256_blend_epi32(up, low, 0x0F);
+}
+
+SIMD_AVX2 static inline __m256i widen_sum(__m256i acc, __m256i x) {
+    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+    return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+}
+
+SIMD_AVX2 static inline long long lane_sum(__m256i v) {
+    alignas(32) long long l[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(l), v);
+    return l[0] + l[1] + l[2] + l[3];
+}
+
+SIMD_AVX2 static inline int lane_min32(__m256i v) {
+    alignas(32) int l[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(l), v);
+    return *min_element(l, l + 8);
+}
+
+SIMD_AVX2 static inline int lane_max32(__m256i v) {
+    alignas(32) int l[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(l), v);
+    return *max_element(l, l + 8);
+}
+
+// Per 8-job block, with S the block-local inclusive prefix sum of bt:
+//   ct[j] = S[j] + max(ct_prev, max_{k<=j} (at[k] - S[k-1]))
+// Everything stays in int32 lanes, which is exact while arrivals lie in
+// [0, 2^30) and the total burst time is below 2^30. That is checked after the
+// pass (from the lane min/max and the 64-bit burst sum); otherwise the
+// scalar 64-bit kernel redoes the run.
+SIMD_AVX2 static bool fcfs_kernel_avx2(const int* at, const int* bt, size_t n, long long* ct_out,
+                                       FcfsKernelResult& r) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i neg_inf = _mm256_set1_epi32(numeric_limits<int>::min());
+    const __m256i last_lane = _mm256_set1_epi32(7);
+    __m256i carry_ct = zero;  // CPU free at T=0
+    __m256i sum_tat = zero, sum_bt = zero;
+    __m256i min_tat = _mm256_set1_epi32(numeric_limits<int>::max());
+    __m256i max_tat = neg_inf;
+    __m256i min_wt = min_tat, max_wt = neg_inf;
+    __m256i min_at = min_tat, max_at = neg_inf, min_bt = min_tat;
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(at + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bt + i));
+
+        // Inclusive prefix sum of bt
+        __m256i s = _mm256_add_epi32(b, _mm256_slli_si256(b, 4));
+        s = _mm256_add_epi32(s, _mm256_slli_si256(s, 8));
+        s = _mm256_add_epi32(s, carry_to_upper_half(s, zero));
+
+        // Prefix max of at[k] - S[k-1]
+        __m256i v = _mm256_sub_epi32(a, _mm256_sub_epi32(s, b));
+        v = _mm256_max_epi32(v, _mm256_blend_epi32(_mm256_slli_si256(v, 4), neg_inf, 0x11));
+        v = _mm256_max_epi32(v, _mm256_blend_epi32(_mm256_slli_si256(v, 8), neg_inf, 0x33));
+        v = _mm256_max_epi32(v, carry_to_upper_half(v, neg_inf));
+
+        __m256i ct = _mm256_add_epi32(s, _mm256_max_epi32(v, carry_ct));
+        if (ct_out) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ct_out + i),
+                                _mm256_cvtepi32_epi64(_mm256_castsi256_si128(ct)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ct_out + i + 4),
+                                _mm256_cvtepi32_epi64(_mm256_extracti128_si256(ct, 1)));
+        }
+
+        __m256i tat = _mm256_sub_epi32(ct, a);
+        __m256i wt = _mm256_sub_epi32(tat, b);
+        sum_tat = widen_sum(sum_tat, tat);
+        sum_bt = widen_sum(sum_bt, b);
+        min_tat = _mm256_min_epi32(min_tat, tat);
+        max_tat = _mm256_max_epi32(max_tat, tat);
+        min_wt = _mm256_min_epi32(min_wt, wt);
+        max_wt = _mm256_max_epi32(max_wt, wt);
+        min_at = _mm256_min_epi32(min_at, a);
+        max_at = _mm256_max_epi32(max_at, a);
+        min_bt = _mm256_min_epi32(min_bt, b);
+
+        carry_ct = _mm256_permutevar8x32_epi32(ct, last_lane);
+    }
+    if (i == 0) return false;
+
+    long long total_bt = lane_sum(sum_bt);
+    if (lane_min32(min_at) < 0 || lane_max32(max_at) >= (1 << 30) ||
+        lane_min32(min_bt) < 0 || total_bt >= (1LL << 30)) {
+        return false;
+    }
+
+    r.tat.sum = lane_sum(sum_tat);
+    r.wt.sum = r.tat.sum - total_bt;
+    r.tat.min = lane_min32(min_tat);
+    r.tat.max = lane_max32(max_tat);
+    r.wt.min = lane_min32(min_wt);
+    r.wt.max = lane_max32(max_wt);
+
+    // Scalar tail continues from the last completion time
+    long long current_time = lane_max32(carry_ct);  // All lanes equal
+    for (; i < n; ++i) {
+        if (current_time < at[i]) current_time = at[i];
+        current_time += bt[i];
+        if (ct_out) ct_out[i] = current_time;
+
+        long long tat = current_time - at[i];
+        long long wt = tat - bt[i];
+        r.tat.sum += tat;
+        r.wt.sum += wt;
+        r.tat.min = min(r.tat.min, tat);
+        r.tat.max = max(r.tat.max, tat);
+        r.wt.min = min(r.wt.min, wt);
+        r.wt.max = max(r.wt.max, wt);
+    }
+    return true;
+}
+
+SIMD_AVX2 static MetricSummary reduce_metric_avx2(const int* values, size_t n) {
+    if (n < 8) return reduce_metric_scalar(values, n);
+
+    __m256i vmin = _mm256_set1_epi32(numeric_limits<int>::max());
+    __m256i vmax = _mm256_set1_epi32(numeric_limits<int>::min());
+    __m256i sum_lo = _mm256_setzero_si256();
+    __m256i sum_hi = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        vmin = _mm256_min_epi32(vmin, x);
+        vmax = _mm256_max_epi32(vmax, x);
+        sum_lo = _mm256_add_epi64(sum_lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        sum_hi = _mm256_add_epi64(sum_hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+
+    alignas(32) int mins[8], maxs[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(mins), vmin);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), vmax);
+
+    MetricSummary s;
+    s.sum = lane_sum(_mm256_add_epi64(sum_lo, sum_hi));
+    s.min = *min_element(mins, mins + 8);
+    s.max = *max_element(maxs, maxs + 8);
+    for (; i < n; ++i) {
+        s.sum += values[i];
+        if (values[i] < s.min) s.min = values[i];
+        if (values[i] > s.max) s.max = values[i];
+    }
+    return s;
+}
+
+static bool detect_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif // SIMD_HAVE_AVX2_PATH
+
+bool simd_avx2_available() {
+#if SIMD_HAVE_AVX2_PATH
+    static const bool available = detect_avx2();
+    return available;
+#else
+    return false;
+#endif
+}
+
+const char* simd_kernel_isa() {
+    return simd_avx2_available() ? "AVX2" : "scalar";
+}
+
+// --- Dispatch ---
+FcfsKernelResult fcfs_kernel(const int* at, const int* bt, size_t n, long long* ct_out) {
+#if SIMD_HAVE_AVX2_PATH
+    FcfsKernelResult r;
+    if (simd_avx2_available() && fcfs_kernel_avx2(at, bt, n, ct_out, r)) return r;
+#endif
+    return fcfs_kernel_scalar(at, bt, n, ct_out);
+}
+
+MetricSummary reduce_metric(const int* values, size_t n) {
+#if SIMD_HAVE_AVX2_PATH
+    if (simd_avx2_available()) return reduce_metric_avx2(values, n);
+#endif
+    return reduce_metric_scalar(values, n);
+}
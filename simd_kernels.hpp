@@ -0,0 +1,35 @@
+#ifndef SIMD_KERNELS_HPP
+#define SIMD_KERNELS_HPP
+
+#include <cstddef>
+
+// Sum / min / max of one per-process metric (TAT or WT)
+struct MetricSummary {
+    long long sum;
+    long long min;
+    long long max;
+};
+
+struct FcfsKernelResult {
+    MetricSummary tat;
+    MetricSummary wt;
+};
+
+// FCFS over SoA columns already in arrival order:
+//   ct[i] = max(ct[i-1], at[i]) + bt[i],  ct[-1] = 0
+// The recurrence is a prefix scan: with S[i] = bt[0] + ... + bt[i],
+//   ct[i] = S[i] + max(0, max_{j<=i} (at[j] - S[j-1]))
+// so the AVX2 path computes a prefix sum and a prefix max per 8-lane block.
+// ct_out may be null when only the metrics are needed.
+FcfsKernelResult fcfs_kernel(const int* at, const int* bt, std::size_t n, long long* ct_out);
+FcfsKernelResult fcfs_kernel_scalar(const int* at, const int* bt, std::size_t n, long long* ct_out);
+
+// Reduction used by every engine at the end of a run (n == 0 gives all zeros)
+MetricSummary reduce_metric(const int* values, std::size_t n);
+MetricSummary reduce_metric_scalar(const int* values, std::size_t n);
+
+// Runtime CPU feature dispatch
+bool simd_avx2_available();
+const char* simd_kernel_isa();
+
+#endif // SIMD_KERNELS_HPP
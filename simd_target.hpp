@@ -0,0 +1,15 @@
+#ifndef SIMD_TARGET_HPP
+#define SIMD_TARGET_HPP
+
+// AVX2 code paths are compiled per function with a target attribute, so the
+// rest of the program keeps the default flags; callers must check
+// simd_avx2_available() before entering one.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define SIMD_HAVE_AVX2_PATH 1
+    #include <immintrin.h>
+    #define SIMD_AVX2 __attribute__((target("avx2")))
+#else
+    #define SIMD_HAVE_AVX2_PATH 0
+#endif
+
+#endif // SIMD_TARGET_HPP
@@ -18,7 +18,7 @@ if exist simulator.exe (
 
 REM 
 REM 
-g++ main.cpp sjf_non_preemptive.cpp fcfscomplete.cpp scheduler_common.cpp priority_non_preemptive.cpp srtf_preemptive.cpp round_robin.cpp comparison_tool.cpp splash_screen.cpp -o simulator.exe -std=c++11 -finput-charset=UTF-8
+g++ main.cpp sjf_non_preemptive.cpp fcfscomplete.cpp scheduler_common.cpp priority_non_preemptive.cpp srtf_preemptive.cpp round_robin.cpp comparison_tool.cpp simd_kernels.cpp batch_engine.cpp perf_counters.cpp engine_context.cpp stream_engine.cpp trace_export.cpp workload_io.cpp result_cache.cpp rr_quantum_search.cpp what_if_session.cpp io_burst_scheduler.cpp splash_screen.cpp batch_compare.cpp results_export.cpp checkpoint.cpp sweep_runner.cpp fused_compare.cpp kinetic_tournament.cpp burst_predictor.cpp arrival_order.cpp external_sort.cpp sim_viewport.cpp live_view.cpp order_statistic.cpp multicore_sim.cpp energy_model.cpp metrics.cpp trace_codec.cpp -o simulator.exe -std=c++11 -pthread -finput-charset=UTF-8
 
 REM
 if %errorlevel% equ 0 (
@@ -1,10 +1,14 @@
 #include "sjf_non_preemptive.hpp"
 #include "scheduler_common.hpp"
+#include "perf_counters.hpp"
+#include "sim_viewport.hpp"
+#include "live_view.hpp"
 #include <algorithm>
 #include <thread>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <memory>
 
 // --- Simulation Display Logic ---
 void printSimulation_sjf(const std::vector<Proc>& processes, int n, int current_time) {
@@ -54,6 +58,19 @@ void printSimulation_sjf(const std::vector<Proc>& processes, int n, int current_
     std::cout << "\n=================================\n";
 }
 
+// One frame: the full listing for small workloads, the viewport otherwise.
+// running is an index into processes, or -1.
+static void show_frame_sjf(SimViewport& view, const std::vector<Proc>& processes, int n, int current_time, int running) {
+    if (!view.active()) {
+        printSimulation_sjf(processes, n, current_time);
+        return;
+    }
+    view.set_time(current_time);
+    view.set_running(running >= 0 ? processes[running].no : -1);
+    if (running >= 0) view.set_progress(processes[running].no, processes[running].progress);
+    view.render("SJF (Non-Preemptive) Scheduling Simulation");
+}
+
 // --- Main SJF Logic Function ---
 void run_sjf_non_preemptive_simulation() {
     int n;
@@ -70,9 +87,11 @@ void run_sjf_non_preemptive_simulation() {
     for (int i = 0; i < n; ++i) {
         p.push_back(read_proc(i + 1));
     }
+    if (run_visual_mode_live(p, ALGO_SJF_NP, 0)) return;
     
     // Initial sort by AT
     std::sort(p.begin(), p.end(), compareByAT);
+    SimViewport view(p, READY_BY_BURST);
 
     std::cout << "\nSimulation starting in 2 seconds...\n";
     std::this_thread::sleep_for(std::chrono::seconds(2));
@@ -86,6 +105,13 @@ void run_sjf_non_preemptive_simulation() {
     const int total_progress_max = 100; 
     const int time_slice_ms = 20;
 
+    // Optional hardware counters (SIM_PERF=1); frames and pacing sleeps are excluded
+    std::unique_ptr<PerfCounters> counters;
+    if (perf_profiling_enabled()) {
+        counters.reset(new PerfCounters());
+        counters->start();
+    }
+
     // --- SJF Execution Loop ---
     while (completed_count < n) {
         
@@ -116,9 +142,10 @@ void run_sjf_non_preemptive_simulation() {
             }
             
             if (next_arrival_time != -1 && current_time < next_arrival_time) {
+                 PerfPause render(counters.get());
                  int idle_start = current_time;
                  while (current_time < next_arrival_time) {
-                      printSimulation_sjf(p, n, current_time);
+                      show_frame_sjf(view, p, n, current_time, -1);
                       current_time++; 
                       std::this_thread::sleep_for(std::chrono::seconds(1));
                  }
@@ -140,13 +167,14 @@ void run_sjf_non_preemptive_simulation() {
         // Time taken for one progress percentage point 
         long long ms_per_percent = total_duration_ms / total_progress_max;
 
+        if (counters) counters->pause(); // The progress animation is all rendering
         while (p[i].progress < total_progress_max) {
             
             if (elapsed_ms >= ms_per_percent * (p[i].progress + 1)) {
                 p[i].progress++;
             }
             
-            printSimulation_sjf(p, n, current_time);
+            show_frame_sjf(view, p, n, current_time, i);
             
             std::this_thread::sleep_for(std::chrono::milliseconds(time_slice_ms));
             elapsed_ms += time_slice_ms;
@@ -155,12 +183,14 @@ void run_sjf_non_preemptive_simulation() {
                  current_time = start_time + (elapsed_ms / 1000);
             }
         }
+        if (counters) counters->resume();
 
         // 4. Completion and Metric Update
         p[i].ct = start_time + p[i].bt;
         p[i].is_completed = true;
         completed_count++;
         current_time = p[i].ct;
+        view.complete(p[i].no, p[i].ct);
 
         // Calculate metrics
         p[i].tat = p[i].ct - p[i].at;
@@ -168,13 +198,17 @@ void run_sjf_non_preemptive_simulation() {
         p[i].wt = p[i].tat - p[i].bt;
         avgwt += p[i].wt;
         
-        printSimulation_sjf(p, n, current_time);
+        if (counters) counters->pause();
+        show_frame_sjf(view, p, n, current_time, -1);
         std::cout << "\nProcess P" << p[i].no << " Completed at T=" << p[i].ct << " (Shortest Job First).\n";
         std::this_thread::sleep_for(std::chrono::seconds(1)); 
+        if (counters) counters->resume();
     }
 
     avgtat /= n;
     avgwt /= n;
+    PerfSample perf_sample = PerfSample();
+    if (counters) perf_sample = counters->stop();
 
     clearScreen();
     std::cout << "\n=== SJF Non-Preemptive Simulation Complete ===" << std::endl;
@@ -198,6 +232,11 @@ void run_sjf_non_preemptive_simulation() {
     std::cout << "\n\033[1;35mAverage Turnaround Time =\033[0m " << avgtat << " seconds" << std::endl;
     std::cout << "\033[1;35mAverage Waiting Time =\033[0m " << avgwt << " seconds" << std::endl;
 
+    if (counters) {
+        print_perf_table(std::vector<std::string>(1, "SJF (NP)"), std::vector<PerfSample>(1, perf_sample),
+                         counters->unavailable_reason());
+    }
+
     std::cout << "\n--- SJF Simulation Finished ---\n" << std::endl;
     
     std::cin.ignore();
@@ -0,0 +1,48 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Lock-free ring for exactly one producer thread and one consumer thread.
+// Slots are written and read in place: the producer claim()s the next free
+// slot, fills it and publish()es it; the consumer reads front() and pop()s
+// it. Neither side ever waits: claim() and front() return null when the
+// ring is full or empty. N must be a power of two.
+template <typename T, std::size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+    SpscRing() : head_(0), tail_(0), slots_(N) {}
+
+    // Producer side
+    T* claim() {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == N) return 0;
+        return &slots_[tail & (N - 1)];
+    }
+    void publish() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    // Consumer side
+    const T* front() const {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return 0;
+        return &slots_[head & (N - 1)];
+    }
+    void pop() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+    // Each index on its own cache line, so the two threads do not share one
+    std::atomic<std::size_t> head_;
+    char head_pad_[64 - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> tail_;
+    char tail_pad_[64 - sizeof(std::atomic<std::size_t>)];
+    std::vector<T> slots_;
+
+    SpscRing(const SpscRing&);
+    SpscRing& operator=(const SpscRing&);
+};
+
+#endif // SPSC_RING_HPP
@@ -1,4 +1,6 @@
 #include "srtf_preemptive.hpp"
+#include "perf_counters.hpp"
+#include "live_view.hpp"
 #include <algorithm>
 #include <thread>
 #include <chrono>
@@ -6,6 +8,7 @@
 #include <sstream>
 #include <limits>
 #include <vector>
+#include <memory>
 
 using namespace std;
 
@@ -27,7 +30,7 @@ vector<SRTFProc> srtf_processes;
 
 
 // --- Simulation Display Logic (SRTF version) ---
-void printSimulation_srtf(const vector<Proc>& processes, int n, int current_time) {
+void printSimulation_srtf(const vector<Proc>& processes, int n, int current_time, const SimViewport& view) {
     clearScreen();
     
     cout << "=== SRTF (Preemptive SJF) Scheduling Simulation ===" << endl;
@@ -36,10 +39,9 @@ void printSimulation_srtf(const vector<Proc>& processes, int n, int current_time
     
     for(int i = 0; i < n; ++i) {
         // Find the corresponding SRTFProc data
-        auto it = find_if(srtf_processes.begin(), srtf_processes.end(), 
-                          [&](const SRTFProc& p) { return p.id == processes[i].no; });
-
-        if (it == srtf_processes.end()) continue;
+        int slot = view.slot_of(processes[i].no);
+        if (slot < 0) continue;
+        auto it = srtf_processes.begin() + slot;
 
         int current_rt = it->remaining_time;
         int total_bt = processes[i].bt;
@@ -84,6 +86,22 @@ void printSimulation_srtf(const vector<Proc>& processes, int n, int current_time
     cout << "\n=================================\n";
 }
 
+// One frame: the full listing for small workloads, the viewport otherwise.
+// running is an index into srtf_processes, or -1.
+static void show_frame_srtf(SimViewport& view, const vector<Proc>& processes, int n, int current_time, int running) {
+    if (!view.active()) {
+        printSimulation_srtf(processes, n, current_time, view);
+        return;
+    }
+    view.set_time(current_time);
+    view.set_running(running >= 0 ? srtf_processes[running].id : -1);
+    if (running >= 0) {
+        const SRTFProc& r = srtf_processes[running];
+        int executed = r.bt - r.remaining_time;
+        view.set_progress(r.id, r.bt == 0 ? 100 : (int)((double)executed * 100.0 / r.bt));
+    }
+    view.render("SRTF (Preemptive SJF) Scheduling Simulation");
+}
 
 // Main SRTF Scheduling Logic
 void run_srtf_preemptive_simulation() {
@@ -112,6 +130,8 @@ void run_srtf_preemptive_simulation() {
         srtf_processes.push_back(new_srtf_proc);
     }
     
+    if (run_visual_mode_live(p, ALGO_SRTF, 0)) return;
+    SimViewport view(p, READY_BY_BURST);   // Built in input order, so its slots index srtf_processes
     sort(p.begin(), p.end(), compareByAT);
 
     cout << "\nProcesses sorted. Simulation starting in 2 seconds...\n";
@@ -124,6 +144,13 @@ void run_srtf_preemptive_simulation() {
     int shortest_job_index = -1; 
     int prev_shortest_job_index = -1;
 
+    // Optional hardware counters (SIM_PERF=1); frames and pacing sleeps are excluded
+    unique_ptr<PerfCounters> counters;
+    if (perf_profiling_enabled()) {
+        counters.reset(new PerfCounters());
+        counters->start();
+    }
+
     while (completed_count < n) {
         
         min_rt = numeric_limits<int>::max();
@@ -153,7 +180,8 @@ void run_srtf_preemptive_simulation() {
             }
 
             if (future_processes_exist) {
-                printSimulation_srtf(p, n, current_time);
+                PerfPause render(counters.get());
+                show_frame_srtf(view, p, n, current_time, -1);
                 cout << "\nCPU is IDLE at T=" << current_time << ". Waiting for next arrival.\n";
                 
                 this_thread::sleep_for(chrono::seconds(1));
@@ -172,12 +200,15 @@ void run_srtf_preemptive_simulation() {
             p[i].progress = 1; 
         }
 
-        printSimulation_srtf(p, n, current_time);
+        if (counters) counters->pause();
+        show_frame_srtf(view, p, n, current_time, i);
         
         this_thread::sleep_for(chrono::seconds(1));
+        if (counters) counters->resume();
 
         srtf_processes[i].remaining_time--;
         current_time++;
+        view.set_ready_key(srtf_processes[i].id, srtf_processes[i].remaining_time, srtf_processes[i].at);
 
         for (int j = 0; j < n; ++j) {
             if (srtf_processes[j].remaining_time > 0 && srtf_processes[j].at <= current_time && j != i) {
@@ -189,12 +220,15 @@ void run_srtf_preemptive_simulation() {
             srtf_processes[i].final_ct = current_time;
             srtf_processes[i].tat = srtf_processes[i].final_ct - srtf_processes[i].at;
             completed_count++;
+            view.complete(srtf_processes[i].id, current_time);
             
             p[i].progress = 0;
             
-            printSimulation_srtf(p, n, current_time);
+            if (counters) counters->pause();
+            show_frame_srtf(view, p, n, current_time, -1);
             cout << "\nProcess P" << srtf_processes[i].id << " COMPLETED at T=" << current_time << ".\n";
             this_thread::sleep_for(chrono::seconds(1)); 
+            if (counters) counters->resume();
         }
 
         prev_shortest_job_index = shortest_job_index;
@@ -219,6 +253,8 @@ void run_srtf_preemptive_simulation() {
 
     avgtat /= n;
     avgwt /= n;
+    PerfSample perf_sample = PerfSample();
+    if (counters) perf_sample = counters->stop();
 
     clearScreen();
     cout << "\n=== SRTF Preemptive Simulation Complete ===" << endl;
@@ -240,6 +276,11 @@ void run_srtf_preemptive_simulation() {
     cout << "\n\033[1;35mAverage Turnaround Time =\033[0m " << avgtat << " seconds" << endl;
     cout << "\033[1;35mAverage Waiting Time =\033[0m " << avgwt << " seconds" << endl;
 
+    if (counters) {
+        print_perf_table(vector<string>(1, "SRTF (P)"), vector<PerfSample>(1, perf_sample),
+                         counters->unavailable_reason());
+    }
+
     cout << "\n--- SRTF Simulation Finished ---\n" << endl;
     
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
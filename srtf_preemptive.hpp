@@ -2,8 +2,10 @@
 #define SRTF_PREEMPTIVE_HPP
 
 #include "scheduler_common.hpp" 
+#include "sim_viewport.hpp"
 
 void run_srtf_preemptive_simulation();
-void printSimulation_srtf(const std::vector<Proc>& processes, int n, int current_time);
+// view maps a process number to its slot in the SRTF tracking data
+void printSimulation_srtf(const std::vector<Proc>& processes, int n, int current_time, const SimViewport& view);
 
 #endif 
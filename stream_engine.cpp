@@ -0,0 +1,321 @@
+#include "stream_engine.hpp"
+#include <algorithm>
+#include <limits>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+const long long NO_ARRIVAL = numeric_limits<long long>::max();
+
+// Min-heap order used with std::push_heap / pop_heap (which build max-heaps)
+struct ReadyAfter {
+    bool operator()(const StreamReadyJob& a, const StreamReadyJob& b) const {
+        if (a.key != b.key) return a.key > b.key;
+        if (a.at != b.at) return a.at > b.at;
+        return a.idx > b.idx;
+    }
+};
+
+template <typename T>
+bool put_raw(FILE* f, const T& v) {
+    return fwrite(&v, sizeof(T), 1, f) == 1;
+}
+
+template <typename T>
+bool get_raw(FILE* f, T& v) {
+    return fread(&v, sizeof(T), 1, f) == 1;
+}
+
+// Field by field, so no struct padding reaches the file
+bool put_job(FILE* f, const StreamReadyJob& j) {
+    return put_raw(f, j.key) && put_raw(f, j.at) && put_raw(f, j.idx) && put_raw(f, j.bt) && put_raw(f, j.rt) &&
+           put_raw(f, j.extra_wt);
+}
+
+bool get_job(FILE* f, StreamReadyJob& j) {
+    return get_raw(f, j.key) && get_raw(f, j.at) && get_raw(f, j.idx) && get_raw(f, j.bt) && get_raw(f, j.rt) &&
+           get_raw(f, j.extra_wt);
+}
+
+bool same_job(const StreamReadyJob& a, const StreamReadyJob& b) {
+    return a.key == b.key && a.at == b.at && a.idx == b.idx &&
+           a.bt == b.bt && a.rt == b.rt && a.extra_wt == b.extra_wt;
+}
+
+} // namespace
+
+string algo_display_name(AlgoId algo, int quantum) {
+    switch (algo) {
+        case ALGO_FCFS:        return "FCFS";
+        case ALGO_SJF_NP:      return "SJF (NP)";
+        case ALGO_PRIORITY_NP: return "Priority (NP)";
+        case ALGO_SRTF:        return "SRTF (P)";
+        case ALGO_RR:          return "RR (Q=" + to_string(quantum) + ")";
+        default:               return "?";
+    }
+}
+
+StreamEngine::StreamEngine(AlgoId algo, int quantum)
+    : algo_(algo), quantum_(quantum), current_time_(0), fed_(0), completed_(0),
+      total_tat_(0), total_wt_(0), min_tat_(numeric_limits<long long>::max()),
+      max_tat_(numeric_limits<long long>::min()), min_wt_(numeric_limits<long long>::max()),
+      max_wt_(numeric_limits<long long>::min()), last_busy_end_(-1), running_(false),
+      running_job_(), slice_end_(0), observer_(0), srtf_on_cpu_(-1) {}
+
+void StreamEngine::push_ready(const StreamReadyJob& j) {
+    if (algo_ == ALGO_RR) {
+        fifo_.push_back(j);
+    } else {
+        heap_.push_back(j);
+        push_heap(heap_.begin(), heap_.end(), ReadyAfter());
+    }
+}
+
+StreamReadyJob StreamEngine::pop_ready() {
+    StreamReadyJob j;
+    if (algo_ == ALGO_RR) {
+        j = fifo_.front();
+        fifo_.pop_front();
+    } else {
+        pop_heap(heap_.begin(), heap_.end(), ReadyAfter());
+        j = heap_.back();
+        heap_.pop_back();
+    }
+    return j;
+}
+
+void StreamEngine::complete(const StreamReadyJob& j, long long ct) {
+    long long tat = ct - j.at;
+    long long wt = tat - j.bt + j.extra_wt;
+    total_tat_ += tat;
+    total_wt_ += wt;
+    min_tat_ = min(min_tat_, tat);
+    max_tat_ = max(max_tat_, tat);
+    min_wt_ = min(min_wt_, wt);
+    max_wt_ = max(max_wt_, wt);
+    completed_++;
+    if (observer_) observer_->on_complete(0, j.idx, ct, wt);
+}
+
+// Run everything that starts before time t (the next arrival)
+void StreamEngine::advance_to(long long t) {
+    switch (algo_) {
+        case ALGO_FCFS:
+            break;
+
+        case ALGO_SJF_NP:
+        case ALGO_PRIORITY_NP:
+            // Non-preemptive: a dispatched job runs to completion
+            while (!heap_.empty() && current_time_ < t) {
+                StreamReadyJob j = pop_ready();
+                if (observer_) observer_->on_run(0, j.idx, current_time_, current_time_ + j.bt);
+                current_time_ += j.bt;
+                complete(j, current_time_);
+            }
+            break;
+
+        case ALGO_SRTF:
+            // The shortest job stays on top while it runs (its key only shrinks)
+            while (!heap_.empty() && current_time_ < t) {
+                StreamReadyJob& top = heap_.front();
+                long long run = min(top.rt, t - current_time_);
+                if (observer_) observer_->on_run(0, top.idx, current_time_, current_time_ + run);
+                current_time_ += run;
+                last_busy_end_ = current_time_;
+                top.rt -= run;
+                top.key = top.rt;
+                srtf_on_cpu_ = top.idx;
+                if (top.rt == 0) {
+                    StreamReadyJob j = pop_ready();
+                    srtf_on_cpu_ = -1;
+                    complete(j, current_time_);
+                }
+            }
+            break;
+
+        case ALGO_RR:
+            for (;;) {
+                if (running_) {
+                    // An arrival inside (or at the end of) the slice queues
+                    // ahead of the preempted job
+                    if (t <= slice_end_) return;
+                    current_time_ = slice_end_;
+                    running_ = false;
+                    if (running_job_.rt == 0) {
+                        complete(running_job_, current_time_);
+                    } else {
+                        if (observer_) observer_->on_preempt(0, running_job_.idx, current_time_, PREEMPT_QUANTUM);
+                        fifo_.push_back(running_job_);
+                    }
+                }
+                if (fifo_.empty() || current_time_ >= t) break;
+                running_job_ = pop_ready();
+                long long run = min(running_job_.rt, (long long)quantum_);
+                running_job_.rt -= run;
+                slice_end_ = current_time_ + run;
+                running_ = true;
+                if (observer_) observer_->on_run(0, running_job_.idx, current_time_, slice_end_);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    // Idle CPU: jump to the next arrival
+    if (!running_ && heap_.empty() && fifo_.empty() && current_time_ < t && t != NO_ARRIVAL) {
+        current_time_ = t;
+    }
+}
+
+void StreamEngine::feed(const Proc& p, int idx) {
+    fed_++;
+    StreamReadyJob j;
+    j.at = p.at;
+    j.idx = idx;
+    j.bt = p.bt;
+    j.rt = p.bt;
+    j.extra_wt = 0;
+    j.key = 0;
+
+    if (algo_ == ALGO_FCFS) {
+        if (current_time_ < p.at) current_time_ = p.at;
+        if (observer_) {
+            observer_->on_arrival(idx, p.at);
+            observer_->on_run(0, idx, current_time_, current_time_ + p.bt);
+        }
+        current_time_ += p.bt;
+        complete(j, current_time_);
+        return;
+    }
+    if (algo_ == ALGO_RR && quantum_ <= 0) return;
+
+    advance_to(p.at);
+    if (observer_) observer_->on_arrival(idx, p.at);
+
+    switch (algo_) {
+        case ALGO_SJF_NP:
+            j.key = p.bt;
+            break;
+        case ALGO_PRIORITY_NP:
+            j.key = p.priority;
+            break;
+        case ALGO_SRTF:
+            if (p.bt <= 0) return;  // calculate_srtf never schedules these
+            j.key = p.bt;
+            // calculate_srtf counts the tick in which a job arrives as waiting
+            // time whenever the CPU was busy during it; keep the engines in step
+            if (last_busy_end_ == p.at) j.extra_wt = 1;
+            break;
+        case ALGO_RR:
+            if (p.bt <= 0) return;  // calculate_rr never queues these
+            break;
+        default:
+            break;
+    }
+    push_ready(j);
+    if (observer_ && algo_ == ALGO_SRTF && last_busy_end_ == p.at && srtf_on_cpu_ >= 0 &&
+        heap_.front().idx != srtf_on_cpu_) {
+        // The job on the CPU lost it to the new arrival
+        observer_->on_preempt(0, srtf_on_cpu_, p.at, PREEMPT_SHORTER_JOB);
+        srtf_on_cpu_ = -1;
+    }
+}
+
+void StreamEngine::finish() {
+    if (algo_ == ALGO_FCFS) return;
+    advance_to(NO_ARRIVAL);
+}
+
+AlgoResult StreamEngine::result(long long n) const {
+    if (n <= 0 || completed_ == 0) return {algo_display_name(algo_, quantum_), 0.0, 0.0, 0, 0, 0, 0};
+    // Jobs the engines never schedule (RR/SRTF with bt <= 0) count as 0
+    bool skipped = completed_ < n;
+    return {algo_display_name(algo_, quantum_), total_tat_ / n, total_wt_ / n,
+            skipped ? min(min_tat_, 0LL) : min_tat_, skipped ? max(max_tat_, 0LL) : max_tat_,
+            skipped ? min(min_wt_, 0LL) : min_wt_, skipped ? max(max_wt_, 0LL) : max_wt_};
+}
+
+bool StreamEngine::same_state(const StreamEngine& other) const {
+    if (algo_ != other.algo_ || quantum_ != other.quantum_ ||
+        current_time_ != other.current_time_ || fed_ != other.fed_ ||
+        completed_ != other.completed_ || last_busy_end_ != other.last_busy_end_ ||
+        running_ != other.running_) {
+        return false;
+    }
+    if (running_ && (slice_end_ != other.slice_end_ || !same_job(running_job_, other.running_job_))) {
+        return false;
+    }
+    if (fifo_.size() != other.fifo_.size() || heap_.size() != other.heap_.size()) return false;
+    for (size_t i = 0; i < fifo_.size(); ++i) {
+        if (!same_job(fifo_[i], other.fifo_[i])) return false;
+    }
+    if (heap_.empty()) return true;
+
+    // Heap layout depends on insertion history; compare the ready sets sorted
+    vector<StreamReadyJob> a(heap_), b(other.heap_);
+    sort(a.begin(), a.end(), ReadyAfter());
+    sort(b.begin(), b.end(), ReadyAfter());
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!same_job(a[i], b[i])) return false;
+    }
+    return true;
+}
+
+void StreamEngine::shift_totals(double d_tat, double d_wt) {
+    total_tat_ += d_tat;
+    total_wt_ += d_wt;
+}
+
+bool StreamEngine::write_state(FILE* f) const {
+    int algo = algo_;
+    unsigned char running = running_ ? 1 : 0;
+    unsigned long long heap_size = heap_.size(), fifo_size = fifo_.size();
+    bool ok = put_raw(f, algo) && put_raw(f, quantum_) && put_raw(f, current_time_) &&
+              put_raw(f, fed_) && put_raw(f, completed_) && put_raw(f, total_tat_) &&
+              put_raw(f, total_wt_) && put_raw(f, min_tat_) && put_raw(f, max_tat_) &&
+              put_raw(f, min_wt_) && put_raw(f, max_wt_) && put_raw(f, last_busy_end_) &&
+              put_raw(f, running) && put_job(f, running_job_) && put_raw(f, slice_end_) &&
+              put_raw(f, srtf_on_cpu_) && put_raw(f, heap_size) && put_raw(f, fifo_size);
+    // The heap is written in its array layout, so reading it back restores the
+    // exact same pop order
+    for (size_t i = 0; ok && i < heap_.size(); ++i) ok = put_job(f, heap_[i]);
+    for (size_t i = 0; ok && i < fifo_.size(); ++i) ok = put_job(f, fifo_[i]);
+    return ok;
+}
+
+bool StreamEngine::read_state(FILE* f, long long max_jobs) {
+    int algo;
+    unsigned char running;
+    unsigned long long heap_size, fifo_size;
+    bool ok = get_raw(f, algo) && get_raw(f, quantum_) && get_raw(f, current_time_) &&
+              get_raw(f, fed_) && get_raw(f, completed_) && get_raw(f, total_tat_) &&
+              get_raw(f, total_wt_) && get_raw(f, min_tat_) && get_raw(f, max_tat_) &&
+              get_raw(f, min_wt_) && get_raw(f, max_wt_) && get_raw(f, last_busy_end_) &&
+              get_raw(f, running) && get_job(f, running_job_) && get_raw(f, slice_end_) &&
+              get_raw(f, srtf_on_cpu_) && get_raw(f, heap_size) && get_raw(f, fifo_size);
+    if (!ok || algo < 0 || algo >= ALGO_COUNT || running > 1 || fed_ < 0 || fed_ > max_jobs ||
+        completed_ < 0 || completed_ > fed_) {
+        return false;
+    }
+    // Only jobs fed and not yet completed can wait, so a corrupt size is
+    // rejected before anything is allocated for it. Compared one at a time:
+    // a sum of the sizes could wrap.
+    unsigned long long waiting = (unsigned long long)(fed_ - completed_);
+    if (running > waiting || heap_size > waiting - running || fifo_size > waiting - running - heap_size) {
+        return false;
+    }
+    algo_ = (AlgoId)algo;
+    running_ = running != 0;
+    heap_.resize(heap_size);
+    for (size_t i = 0; ok && i < heap_.size(); ++i) ok = get_job(f, heap_[i]);
+    fifo_.clear();
+    for (unsigned long long i = 0; ok && i < fifo_size; ++i) {
+        StreamReadyJob j;
+        ok = get_job(f, j);
+        fifo_.push_back(j);
+    }
+    return ok;
+}
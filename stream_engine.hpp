@@ -0,0 +1,121 @@
+#ifndef STREAM_ENGINE_HPP
+#define STREAM_ENGINE_HPP
+
+#include <cstdio>
+#include <vector>
+#include <deque>
+#include "scheduler_common.hpp"
+#include "comparison_tool.hpp"
+
+// Algorithms in the order run_all_algorithms_comparison reports them
+enum AlgoId {
+    ALGO_FCFS,
+    ALGO_SJF_NP,
+    ALGO_PRIORITY_NP,
+    ALGO_SRTF,
+    ALGO_RR,
+    ALGO_COUNT
+};
+
+// Ready-set entry of a streaming engine
+struct StreamReadyJob {
+    long long key;  // SJF: bt, Priority: priority, SRTF: remaining time
+    int at;
+    int idx;        // Job index in the caller's workload (last tie-breaker)
+    int bt;
+    long long rt;   // Remaining time (SRTF / RR)
+    int extra_wt;   // SRTF arrival-tick adjustment, see StreamEngine::feed
+};
+
+enum PreemptReason {
+    PREEMPT_QUANTUM,       // RR quantum expired
+    PREEMPT_SHORTER_JOB    // SRTF: a job with less remaining time arrived
+};
+
+// Receives the schedule as a StreamEngine produces it. Jobs are identified by
+// the index passed to feed(); times are in simulated seconds. A job that keeps
+// the CPU across an arrival may be reported as back-to-back run segments.
+// on_complete carries the waiting time the engine counted for the job.
+class ScheduleObserver {
+public:
+    virtual ~ScheduleObserver() {}
+    virtual void on_arrival(int idx, long long t) = 0;
+    virtual void on_run(int cpu, int idx, long long start, long long end) = 0;
+    virtual void on_preempt(int cpu, int idx, long long t, PreemptReason why) = 0;
+    virtual void on_complete(int cpu, int idx, long long t, long long wt) = 0;
+};
+
+// Event-driven version of the calculate_* engines. Arrivals are fed one at a
+// time in (at, idx) order and the engine only simulates up to the newest
+// arrival, so it never needs the whole trace. Averages match calculate_*
+// exactly (FCFS breaks equal arrival times by index). The whole state is a
+// plain value: copying the engine is a checkpoint.
+class StreamEngine {
+public:
+    explicit StreamEngine(AlgoId algo = ALGO_FCFS, int quantum = 0);
+
+    void feed(const Proc& p, int idx);  // Next arrival
+    void finish();                      // No more arrivals: run to completion
+
+    // Runs everything that starts before t; t must not be later than the next
+    // arrival. finish() in steps, for callers that need control in between.
+    void run_until(long long t) { advance_to(t); }
+    bool idle() const { return !running_ && heap_.empty() && fifo_.empty(); }
+
+    // Raw binary state (native byte order), e.g. for checkpoint files. The
+    // observer is not part of it. read_state rejects states that claim more
+    // than max_jobs fed jobs (the workload size) and leaves the engine
+    // unusable on failure.
+    bool write_state(std::FILE* f) const;
+    bool read_state(std::FILE* f, long long max_jobs);
+
+    AlgoResult result(long long n) const;
+
+    // True when both engines will produce the same schedule from here on
+    // (accumulated totals are not compared)
+    bool same_state(const StreamEngine& other) const;
+
+    void shift_totals(double d_tat, double d_wt);
+
+    // Optional; not part of the state compared by same_state()
+    void set_observer(ScheduleObserver* observer) { observer_ = observer; }
+
+    AlgoId algo() const { return algo_; }
+    long long fed() const { return fed_; }
+    long long completed() const { return completed_; }
+    long long current_time() const { return current_time_; }
+    long long queued() const { return (long long)(heap_.size() + fifo_.size()); }
+    double total_tat() const { return total_tat_; }
+    double total_wt() const { return total_wt_; }
+
+private:
+    void advance_to(long long t);
+    void complete(const StreamReadyJob& j, long long ct);
+    void push_ready(const StreamReadyJob& j);
+    StreamReadyJob pop_ready();
+
+    AlgoId algo_;
+    int quantum_;
+    long long current_time_;
+    long long fed_;
+    long long completed_;
+    double total_tat_;
+    double total_wt_;
+    long long min_tat_, max_tat_, min_wt_, max_wt_;
+    long long last_busy_end_;      // SRTF: end of the latest CPU segment
+
+    bool running_;                 // RR: a quantum slice is in progress
+    StreamReadyJob running_job_;
+    long long slice_end_;
+
+    std::vector<StreamReadyJob> heap_;   // SJF / Priority / SRTF
+    std::deque<StreamReadyJob> fifo_;    // RR
+
+    ScheduleObserver* observer_;
+    int srtf_on_cpu_;              // Observer bookkeeping: SRTF job that ran last
+};
+
+// Display name used by the comparison table
+std::string algo_display_name(AlgoId algo, int quantum);
+
+#endif // STREAM_ENGINE_HPP
@@ -0,0 +1,539 @@
+#include "sweep_runner.hpp"
+#include "batch_compare.hpp"
+#include "workload_io.hpp"
+#include "arrival_order.hpp"
+#include "rr_quantum_search.hpp"
+#include "result_cache.hpp"
+#include "metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <new>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+    #include <cstdlib>
+#else
+    #include <cerrno>
+    #include <sys/mman.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+// Slot states; a claimed slot holds SLOT_CLAIMED + the claiming worker's id,
+// so claiming and recording the owner is a single compare-and-swap
+enum SlotState { SLOT_PENDING, SLOT_DONE, SLOT_FAILED, SLOT_CLAIMED };
+
+struct SweepSlot {
+    atomic<int> state;
+    int attempts;       // Workers lost while running this task (coordinator only)
+    double avg_tat, avg_wt;
+    long long min_tat, max_tat, min_wt, max_wt, switches;
+    double seconds;     // Wall time of the run, for the live metrics
+};
+
+// Start of the shared result mapping, followed by one SweepSlot per task
+struct SweepTable {
+    atomic<long long> next;   // First-pass claim cursor
+    atomic<long long> done;
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+              "shared-memory slots need address-free atomics");
+
+// Read-only workload mapping: offsets and counts per workload, then every
+// workload's jobs back to back, then each workload's (at, index) order
+struct WorkloadView {
+    const long long* offset;
+    const long long* count;
+    const Proc* procs;
+    const int* order;
+};
+
+class SwitchCounter : public ScheduleObserver {
+public:
+    SwitchCounter() : last_(-1), switches_(0) {}
+    void on_arrival(int, long long) {}
+    void on_run(int, int idx, long long, long long) {
+        if (idx != last_) switches_++;
+        last_ = idx;
+    }
+    void on_preempt(int, int, long long, PreemptReason) {}
+    void on_complete(int, int, long long, long long) {}
+    long long switches() const { return switches_; }
+
+private:
+    int last_;
+    long long switches_;
+};
+
+void* map_shared(size_t bytes) {
+#ifdef _WIN32
+    return malloc(bytes);
+#else
+    void* p = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    return p == MAP_FAILED ? 0 : p;
+#endif
+}
+
+void unmap_shared(void* p, size_t bytes) {
+#ifdef _WIN32
+    (void)bytes;
+    free(p);
+#else
+    munmap(p, bytes);
+#endif
+}
+
+void simulate_task(const WorkloadView& w, const SweepTask& task, SweepSlot& slot) {
+    const Proc* procs = w.procs + w.offset[task.workload];
+    const int* order = w.order + w.offset[task.workload];
+    long long n = w.count[task.workload];
+
+    if (task.algo == ALGO_RR && task.quantum == 0) {
+        vector<Proc> copy(procs, procs + n);
+        EngineContext ctx(copy.size());
+        QuantumEval e = RRQuantumEvaluator(copy).evaluate_adaptive(ADAPTIVE_RR_PERCENTILE, OBJ_AVG_WT, 0.0, ctx);
+        slot.avg_tat = e.avg_tat;
+        slot.avg_wt = e.avg_wt;
+        slot.min_tat = e.min_tat;
+        slot.max_tat = e.max_tat;
+        slot.min_wt = e.min_wt;
+        slot.max_wt = e.max_wt;
+        slot.switches = e.context_switches;
+        return;
+    }
+
+    StreamEngine engine(task.algo, task.quantum);
+    SwitchCounter counter;
+    engine.set_observer(&counter);
+    for (long long i = 0; i < n; ++i) engine.feed(procs[order[i]], order[i]);
+    engine.finish();
+
+    AlgoResult r = engine.result(n);
+    slot.avg_tat = r.avg_tat;
+    slot.avg_wt = r.avg_wt;
+    slot.min_tat = r.min_tat;
+    slot.max_tat = r.max_tat;
+    slot.min_wt = r.min_wt;
+    slot.max_wt = r.max_wt;
+    slot.switches = counter.switches();
+}
+
+void run_task(const WorkloadView& w, const SweepTask& task, SweepSlot& slot) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    simulate_task(w, task, slot);
+    slot.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Live metrics for the coordinator. Workers may be other processes, so their
+// run times reach the registry through the shared slots.
+struct SweepMetrics {
+    bool enabled;
+    vector<char> recorded;
+    MetricGauge& done;
+    MetricGauge& workers;
+    MetricCounter& crashes;
+
+    SweepMetrics(bool on, size_t tasks)
+        : enabled(on), recorded(on ? tasks : 0, 0),
+          done(metrics().gauge("sched_sweep_tasks_done", "Simulations finished in the current sweep.")),
+          workers(metrics().gauge("sched_sweep_workers", "Sweep workers currently running.")),
+          crashes(metrics().counter("sched_sweep_worker_crashes_total", "Sweep workers that died.")) {
+        metrics().gauge("sched_sweep_tasks", "Simulations in the current sweep.").set((double)tasks);
+    }
+
+    void update(const WorkloadView& w, const vector<SweepTask>& tasks, const SweepSlot* slots, long long finished,
+                size_t live) {
+        if (!enabled) return;
+        done.set((double)finished);
+        workers.set((double)live);
+        for (size_t t = 0; t < tasks.size(); ++t) {
+            if (recorded[t] || slots[t].state.load() != SLOT_DONE) continue;
+            recorded[t] = 1;
+            record_engine_run(tasks[t].algo, w.count[tasks[t].workload], slots[t].seconds);
+        }
+    }
+};
+
+bool claim(SweepSlot& slot, int wid) {
+    int expected = SLOT_PENDING;
+    return slot.state.compare_exchange_strong(expected, SLOT_CLAIMED + wid);
+}
+
+void worker_loop(const WorkloadView& w, const vector<SweepTask>& tasks, SweepTable* table,
+                 SweepSlot* slots, int wid) {
+    long long n = (long long)tasks.size();
+    for (;;) {
+        long long t = table->next.fetch_add(1);
+        if (t >= n || !claim(slots[t], wid)) {
+            // Cursor exhausted: pick up tasks put back after a worker died
+            for (t = 0; t < n && !claim(slots[t], wid); ++t) {}
+            if (t == n) return;
+        }
+        run_task(w, tasks[t], slots[t]);
+        slots[t].state.store(SLOT_DONE);
+        table->done.fetch_add(1);
+    }
+}
+
+#ifndef _WIN32
+
+// Returns the number of tasks put back in the queue
+long long release_claims(SweepSlot* slots, long long n, int wid, SweepStats& stats) {
+    long long requeued = 0;
+    for (long long t = 0; t < n; ++t) {
+        if (slots[t].state.load() != SLOT_CLAIMED + wid) continue;
+        if (++slots[t].attempts >= SWEEP_MAX_ATTEMPTS) {
+            slots[t].state.store(SLOT_FAILED);
+            stats.tasks_failed++;
+        } else {
+            slots[t].state.store(SLOT_PENDING);
+            stats.tasks_retried++;
+            requeued++;
+        }
+    }
+    return requeued;
+}
+
+bool has_pending(SweepSlot* slots, long long n) {
+    for (long long t = 0; t < n; ++t) {
+        if (slots[t].state.load() == SLOT_PENDING) return true;
+    }
+    return false;
+}
+
+void print_progress(long long done, long long total) {
+    cout << "\rCompleted " << done << " / " << total << " tasks" << flush;
+}
+
+bool run_workers(const WorkloadView& w, const vector<SweepTask>& tasks, SweepTable* table,
+                 SweepSlot* slots, int workers, SweepStats& stats, SweepMetrics& live_metrics, string& error) {
+    long long n = (long long)tasks.size();
+    map<pid_t, int> live;   // pid -> worker id
+    int next_wid = 0;
+
+    auto spawn = [&]() -> bool {
+        cout.flush();
+        fflush(stdout);
+        int wid = next_wid++;
+        pid_t pid = fork();
+        if (pid < 0) return false;
+        if (pid == 0) {
+            worker_loop(w, tasks, table, slots, wid);
+            _exit(0);
+        }
+        live[pid] = wid;
+        stats.workers_started++;
+        return true;
+    };
+
+    for (int i = 0; i < workers; ++i) {
+        if (!spawn()) break;
+    }
+
+    long long shown = -1;
+    while (!live.empty()) {
+        int status;
+        pid_t pid = waitpid(-1, &status, WNOHANG);
+        if (pid < 0 && errno != EINTR) break;
+        if (pid <= 0) {
+            long long done = table->done.load();
+            if (done != shown) print_progress(shown = done, n);
+            live_metrics.update(w, tasks, slots, done, live.size());
+            usleep(50000);
+            continue;
+        }
+        map<pid_t, int>::iterator it = live.find(pid);
+        if (it == live.end()) continue;
+        int wid = it->second;
+        live.erase(it);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) continue;
+
+        stats.workers_crashed++;
+        live_metrics.crashes.add();
+        if (release_claims(slots, n, wid, stats) > 0 || has_pending(slots, n)) spawn();
+    }
+    print_progress(table->done.load(), n);
+    cout << endl;
+    live_metrics.update(w, tasks, slots, table->done.load(), 0);
+
+    for (long long t = 0; t < n; ++t) {
+        int s = slots[t].state.load();
+        if (s != SLOT_DONE && s != SLOT_FAILED) {
+            error = "could not start worker processes";
+            return false;
+        }
+    }
+    return true;
+}
+
+#else
+
+bool run_workers(const WorkloadView& w, const vector<SweepTask>& tasks, SweepTable* table,
+                 SweepSlot* slots, int workers, SweepStats& stats, SweepMetrics& live_metrics, string&) {
+    long long n = (long long)tasks.size();
+    vector<thread> pool;
+    for (int i = 0; i < workers; ++i) {
+        pool.push_back(thread(worker_loop, cref(w), cref(tasks), table, slots, i));
+        stats.workers_started++;
+    }
+    while (live_metrics.enabled && table->done.load() < n) {
+        live_metrics.update(w, tasks, slots, table->done.load(), pool.size());
+        this_thread::sleep_for(chrono::milliseconds(50));
+    }
+    for (size_t i = 0; i < pool.size(); ++i) pool[i].join();
+    live_metrics.update(w, tasks, slots, table->done.load(), 0);
+    return true;
+}
+
+#endif
+
+} // namespace
+
+vector<SweepTask> make_sweep_tasks(int workloads, const vector<int>& quanta) {
+    vector<SweepTask> tasks;
+    for (int w = 0; w < workloads; ++w) {
+        for (int a = 0; a < ALGO_COUNT; ++a) {
+            if (a != ALGO_RR) {
+                SweepTask t = {w, (AlgoId)a, 0};
+                tasks.push_back(t);
+                continue;
+            }
+            for (size_t q = 0; q < quanta.size(); ++q) {
+                SweepTask t = {w, ALGO_RR, quanta[q]};
+                tasks.push_back(t);
+            }
+            SweepTask adaptive = {w, ALGO_RR, 0};
+            tasks.push_back(adaptive);
+        }
+    }
+    return tasks;
+}
+
+bool run_sweep(const vector<vector<Proc> >& workloads, const vector<SweepTask>& all_tasks,
+               int workers, vector<SweepRow>& rows, SweepStats& stats, string& error) {
+    stats.workers_started = 0;
+    stats.workers_crashed = 0;
+    stats.tasks_retried = 0;
+    stats.tasks_failed = 0;
+    stats.tasks_cached = 0;
+    rows.clear();
+    if (workers <= 0) workers = (int)max(1u, thread::hardware_concurrency());
+
+    // Tasks the result cache can answer (with a context-switch count) never
+    // reach a worker. Fresh results are stored from here once the workers are
+    // done, so worker processes never append to the cache file.
+    ResultCache* cache = default_result_cache();
+    vector<ResultCacheKey> keys;
+    vector<SweepRow> known(all_tasks.size());
+    vector<SweepTask> tasks;        // The ones left to run
+    vector<size_t> task_of;         // Their index in all_tasks
+    if (cache) {
+        vector<WorkloadHash> hashes;
+        for (size_t i = 0; i < workloads.size(); ++i) hashes.push_back(hash_workload(workloads[i]));
+        for (size_t t = 0; t < all_tasks.size(); ++t) {
+            const SweepTask& task = all_tasks[t];
+            keys.push_back(make_cache_key(hashes[task.workload], task.algo, task.quantum));
+            AlgoResult r;
+            long long switches = -1;
+            known[t].ok = cache->lookup(keys[t], r, &switches) && switches >= 0;
+            if (!known[t].ok) continue;
+            SweepRow row = {task, true, r.avg_tat, r.avg_wt, r.min_tat, r.max_tat, r.min_wt, r.max_wt, switches};
+            known[t] = row;
+            stats.tasks_cached++;
+        }
+    }
+    for (size_t t = 0; t < all_tasks.size(); ++t) {
+        if (cache && known[t].ok) continue;
+        tasks.push_back(all_tasks[t]);
+        task_of.push_back(t);
+    }
+
+    // Read-only workload mapping, shared with the workers instead of copied
+    size_t nw = workloads.size();
+    long long total = 0;
+    for (size_t i = 0; i < nw; ++i) total += (long long)workloads[i].size();
+    size_t data_bytes = 2 * nw * sizeof(long long) + total * (sizeof(Proc) + sizeof(int));
+    char* data = (char*)map_shared(max(data_bytes, (size_t)1));
+    if (!data) {
+        error = "cannot map the workloads";
+        return false;
+    }
+    long long* offset = (long long*)data;
+    long long* count = offset + nw;
+    Proc* procs = (Proc*)(count + nw);
+    int* order = (int*)(procs + total);
+    long long at = 0;
+    for (size_t i = 0; i < nw; ++i) {
+        const vector<Proc>& p = workloads[i];
+        offset[i] = at;
+        count[i] = (long long)p.size();
+        copy(p.begin(), p.end(), procs + at);
+        int* o = order + at;
+        // StreamEngine takes arrivals in (at, index) order
+        arrival_order(p.data(), (int)p.size(), o);
+        at += (long long)p.size();
+    }
+#ifndef _WIN32
+    mprotect(data, max(data_bytes, (size_t)1), PROT_READ);
+#endif
+    WorkloadView view = {offset, count, procs, order};
+
+    // Shared result table
+    size_t table_bytes = sizeof(SweepTable) + tasks.size() * sizeof(SweepSlot);
+    char* mem = (char*)map_shared(table_bytes);
+    if (!mem) {
+        unmap_shared(data, max(data_bytes, (size_t)1));
+        error = "cannot map the result table";
+        return false;
+    }
+    SweepTable* table = new (mem) SweepTable();
+    table->next.store(0);
+    table->done.store(0);
+    SweepSlot* slots = (SweepSlot*)(mem + sizeof(SweepTable));
+    for (size_t t = 0; t < tasks.size(); ++t) {
+        SweepSlot* s = new (slots + t) SweepSlot();
+        s->state.store(SLOT_PENDING);
+        s->attempts = 0;
+    }
+
+    MetricsSession session;
+    SweepMetrics live_metrics(session.active(), tasks.size());
+    bool ok = tasks.empty() || run_workers(view, tasks, table, slots, workers, stats, live_metrics, error);
+    if (ok) {
+        for (size_t t = 0; t < tasks.size(); ++t) {
+            const SweepSlot& s = slots[t];
+            SweepRow row = {tasks[t], s.state.load() == SLOT_DONE, s.avg_tat, s.avg_wt,
+                            s.min_tat, s.max_tat, s.min_wt, s.max_wt, s.switches};
+            known[task_of[t]] = row;
+            if (cache && row.ok) {
+                AlgoResult r = {algo_display_name(row.task.algo, row.task.quantum), row.avg_tat, row.avg_wt,
+                                row.min_tat, row.max_tat, row.min_wt, row.max_wt};
+                cache->store(keys[task_of[t]], r, row.context_switches);
+            }
+        }
+        rows.swap(known);
+    }
+
+    unmap_shared(mem, table_bytes);
+    unmap_shared(data, max(data_bytes, (size_t)1));
+    return ok;
+}
+
+// --- MENU ENTRY ---
+template <typename T>
+static bool parse_list(const string& text, vector<T>& values) {
+    values.clear();
+    string item;
+    istringstream in(text);
+    while (getline(in, item, ',')) {
+        istringstream field(item);
+        T v;
+        if (!(field >> v) || v < 0) return false;
+        values.push_back(v);
+    }
+    return !values.empty();
+}
+
+void run_sweep_menu() {
+    cout << "\n<-- Multi-Process Parameter Sweep Selected -->" << endl;
+    string input, output, quanta_text, costs_text;
+    vector<int> quanta;
+    vector<double> costs;
+    int workers;
+
+    cout << "Workload directory or glob (e.g. traces/*.txt): ";
+    cin >> input;
+    cout << "Round Robin quanta (comma-separated, e.g. 1,2,4,8): ";
+    cin >> quanta_text;
+    if (!parse_list(quanta_text, quanta) || count(quanta.begin(), quanta.end(), 0) > 0) {
+        cout << "Invalid quanta. Using Q=2 for RR." << endl;
+        quanta.assign(1, 2);
+    }
+    cout << "Context-switch costs in seconds (comma-separated, e.g. 0,0.5): ";
+    cin >> costs_text;
+    if (!parse_list(costs_text, costs)) {
+        cout << "Invalid costs. Using 0." << endl;
+        costs.assign(1, 0.0);
+    }
+    cout << "Worker processes (0 = one per hardware thread): ";
+    if (!(cin >> workers) || workers < 0) {
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        workers = 0;
+    }
+    cout << "Output CSV file: ";
+    cin >> output;
+
+    vector<string> files;
+    vector<vector<Proc> > workloads;
+    string error;
+    bool ok = list_trace_files(input, files, error);
+    for (size_t i = 0; ok && i < files.size(); ++i) {
+        workloads.push_back(vector<Proc>());
+        ok = load_workload_file(files[i], workloads.back(), error);
+    }
+
+    vector<SweepRow> rows;
+    SweepStats stats;
+    FILE* out = 0;
+    if (ok) ok = run_sweep(workloads, make_sweep_tasks((int)workloads.size(), quanta), workers, rows, stats, error);
+    if (ok && !(out = fopen(output.c_str(), "w"))) {
+        error = "cannot create " + output;
+        ok = false;
+    }
+
+    if (!ok) {
+        cout << "\nSweep failed: " << error << endl;
+    } else {
+        // The cost does not change the schedule; it is charged per switch as in
+        // the quantum optimizer's weighted objective
+        fprintf(out, "file,algorithm,quantum,switch_cost,avg_tat,avg_wt,min_tat,max_tat,min_wt,max_wt,"
+                     "context_switches,weighted\n");
+        for (size_t r = 0; r < rows.size(); ++r) {
+            const SweepRow& row = rows[r];
+            if (!row.ok) continue;
+            long long n = (long long)workloads[row.task.workload].size();
+            for (size_t c = 0; c < costs.size(); ++c) {
+                double weighted = (row.avg_wt + row.avg_tat) / 2.0 +
+                                  (n > 0 ? costs[c] * (double)row.context_switches / n : 0.0);
+                string name = row.task.algo == ALGO_RR && row.task.quantum == 0
+                                  ? "RR (Adaptive P" + to_string(ADAPTIVE_RR_PERCENTILE) + ")"
+                                  : algo_display_name(row.task.algo, row.task.quantum);
+                fprintf(out, "%s,%s,%d,%g,%.4f,%.4f,%lld,%lld,%lld,%lld,%lld,%.4f\n",
+                        csv_field(files[row.task.workload]).c_str(), name.c_str(), row.task.quantum,
+                        costs[c], row.avg_tat, row.avg_wt, row.min_tat, row.max_tat, row.min_wt,
+                        row.max_wt, row.context_switches, weighted);
+            }
+        }
+        bool write_ok = !ferror(out);
+        if (fclose(out) != 0) write_ok = false;
+
+        cout << "\n" << rows.size() - stats.tasks_failed << " of " << rows.size() << " simulations completed on "
+             << stats.workers_started << " worker(s)";
+        if (stats.tasks_cached > 0) cout << " (" << stats.tasks_cached << " answered by the result cache)";
+        if (write_ok) {
+            cout << "; results written to " << output << endl;
+        } else {
+            cout << "; writing " << output << " failed" << endl;
+        }
+        if (stats.workers_crashed > 0) {
+            cout << stats.workers_crashed << " worker(s) died; " << stats.tasks_retried << " task(s) were rerun and "
+                 << stats.tasks_failed << " gave up after " << SWEEP_MAX_ATTEMPTS << " attempts." << endl;
+        }
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
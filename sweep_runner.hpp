@@ -0,0 +1,53 @@
+#ifndef SWEEP_RUNNER_HPP
+#define SWEEP_RUNNER_HPP
+
+#include <string>
+#include <vector>
+#include "scheduler_common.hpp"
+#include "stream_engine.hpp"
+
+// One simulation of a sweep
+struct SweepTask {
+    int workload;       // Index into the workload list
+    AlgoId algo;
+    int quantum;        // RR only, 0 otherwise; RR with 0 is the adaptive-quantum baseline
+};
+
+struct SweepRow {
+    SweepTask task;
+    bool ok;            // False: every attempt crashed its worker
+    double avg_tat;
+    double avg_wt;
+    long long min_tat, max_tat, min_wt, max_wt;
+    long long context_switches;   // Dispatches of a different job than the one before
+};
+
+struct SweepStats {
+    int workers_started;
+    int workers_crashed;          // Killed by a signal or exited with an error
+    long long tasks_retried;
+    long long tasks_failed;
+    long long tasks_cached;       // Answered by the result cache without a worker
+};
+
+// Every workload with each non-RR algorithm once, RR once per quantum and
+// once with the adaptive quantum (median of the ready queue's remaining times)
+std::vector<SweepTask> make_sweep_tasks(int workloads, const std::vector<int>& quanta);
+
+// Runs the tasks on `workers` processes (<= 0: hardware thread count). The
+// workloads are copied once into a read-only shared mapping that every forked
+// worker sees; workers claim tasks by compare-and-swap on the slots of a
+// shared result table and write their rows there. A worker that dies has its
+// claimed tasks put back and is replaced; a task that has taken down
+// SWEEP_MAX_ATTEMPTS workers is reported as failed. Without fork() (Windows)
+// the same table is worked by threads, without the crash isolation. Tasks
+// found in the result cache are not run; new results are added to it by the
+// calling process.
+const int SWEEP_MAX_ATTEMPTS = 3;
+bool run_sweep(const std::vector<std::vector<Proc> >& workloads, const std::vector<SweepTask>& tasks,
+               int workers, std::vector<SweepRow>& rows, SweepStats& stats, std::string& error);
+
+// Menu entry
+void run_sweep_menu();
+
+#endif // SWEEP_RUNNER_HPP
@@ -0,0 +1,501 @@
+// 64-bit off_t for fseeko/ftello where long is 32 bits
+#define _FILE_OFFSET_BITS 64
+#include "trace_codec.hpp"
+#include "workload_io.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+const char TRACE_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'T', 'Z', '1'};
+const char TRACE_END_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'T', 'Z', 'E'};
+const uint32_t TRACE_VERSION = 1;
+const int COLUMNS = 5;                                  // AT, BT, PRIORITY, CLASS, WSS
+const size_t HEADER_BYTES = 8 + 4 + 4 + 8;
+const size_t BLOCK_HEADER_BYTES = 4 + 4 * COLUMNS;
+const size_t INDEX_ENTRY_BYTES = 8 + 4;
+const size_t FOOTER_BYTES = 8 + 8 + 8;
+const size_t MAX_VARINT_BYTES = 10;
+
+// Size of an open file, rewound to the start; -1 on failure. Not ftell, whose
+// long cannot hold sizes of 2 GB and more on Windows and 32-bit systems.
+long long file_size(FILE* f) {
+#ifdef _WIN32
+    if (_fseeki64(f, 0, SEEK_END) != 0) return -1;
+    long long size = _ftelli64(f);
+    return _fseeki64(f, 0, SEEK_SET) == 0 ? size : -1;
+#else
+    if (fseeko(f, 0, SEEK_END) != 0) return -1;
+    long long size = (long long)ftello(f);
+    return fseeko(f, 0, SEEK_SET) == 0 ? size : -1;
+#endif
+}
+
+template <typename T>
+void put_field(unsigned char*& p, T v) {
+    memcpy(p, &v, sizeof(v));
+    p += sizeof(v);
+}
+
+template <typename T>
+T get_field(const unsigned char*& p) {
+    T v;
+    memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    return v;
+}
+
+inline uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+inline int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+inline void put_varint(vector<unsigned char>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((unsigned char)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((unsigned char)v);
+}
+
+// One column of a block. Values that cannot appear in a valid column (more
+// than 10 bytes, or running past the column) leave ok false.
+class VarintCursor {
+public:
+    VarintCursor(const unsigned char* p, const unsigned char* end) : p_(p), end_(end), ok_(true) {}
+
+    uint64_t next() {
+        // Far enough from the end that the longest varint cannot overrun it
+        if (end_ - p_ >= (ptrdiff_t)MAX_VARINT_BYTES) {
+            uint64_t b = *p_++;
+            if (b < 0x80) return b;
+            uint64_t v = b & 0x7f;
+            for (int shift = 7; shift < 70; shift += 7) {
+                b = *p_++;
+                v |= (b & 0x7f) << shift;
+                if (b < 0x80) return v;
+            }
+            ok_ = false;
+            return 0;
+        }
+        uint64_t v = 0;
+        for (int shift = 0; shift < 70 && p_ < end_; shift += 7) {
+            uint64_t b = *p_++;
+            v |= (b & 0x7f) << shift;
+            if (b < 0x80) return v;
+        }
+        ok_ = false;
+        return 0;
+    }
+
+    bool ok() const { return ok_; }
+    bool done() const { return p_ == end_; }
+
+private:
+    const unsigned char* p_;
+    const unsigned char* end_;
+    bool ok_;
+};
+
+void encode_block(const Proc* procs, uint32_t rows, vector<unsigned char> columns[COLUMNS],
+                  vector<unsigned char>& out) {
+    for (int c = 0; c < COLUMNS; ++c) columns[c].clear();
+    int64_t prev_at = 0;
+    for (uint32_t i = 0; i < rows; ++i) {
+        const Proc& p = procs[i];
+        put_varint(columns[0], zigzag((int64_t)p.at - prev_at));
+        prev_at = p.at;
+        put_varint(columns[1], (uint32_t)p.bt);
+        put_varint(columns[2], zigzag(p.priority));
+        put_varint(columns[3], zigzag(p.job_class));
+        put_varint(columns[4], (uint32_t)p.working_set);
+    }
+
+    size_t payload = 0;
+    for (int c = 0; c < COLUMNS; ++c) payload += columns[c].size();
+    out.resize(BLOCK_HEADER_BYTES + payload);
+    unsigned char* h = &out[0];
+    put_field<uint32_t>(h, rows);
+    for (int c = 0; c < COLUMNS; ++c) put_field<uint32_t>(h, (uint32_t)columns[c].size());
+    for (int c = 0; c < COLUMNS; ++c) {
+        if (!columns[c].empty()) memcpy(h, &columns[c][0], columns[c].size());
+        h += columns[c].size();
+    }
+}
+
+// Decodes a block of `rows` processes into out, numbering them from first_no.
+// Returns an empty string, or what is wrong with the block.
+string decode_block(const unsigned char* data, size_t len, uint32_t rows, long long first_no, Proc* out) {
+    if (len < BLOCK_HEADER_BYTES) return "truncated block";
+    const unsigned char* h = data;
+    if (get_field<uint32_t>(h) != rows) return "block row count does not match the index";
+    const unsigned char* col[COLUMNS + 1];
+    col[0] = data + BLOCK_HEADER_BYTES;
+    for (int c = 0; c < COLUMNS; ++c) {
+        uint32_t bytes = get_field<uint32_t>(h);
+        if (bytes > (size_t)(data + len - col[c])) return "truncated block";
+        col[c + 1] = col[c] + bytes;
+    }
+
+    VarintCursor at(col[0], col[1]), bt(col[1], col[2]), priority(col[2], col[3]), job_class(col[3], col[4]),
+        working_set(col[4], col[5]);
+    const uint64_t int_max = (uint64_t)numeric_limits<int>::max();
+    const uint64_t uint_max = numeric_limits<uint32_t>::max();
+    int64_t prev_at = 0;
+    bool in_range = true;
+    for (uint32_t i = 0; i < rows; ++i) {
+        Proc& p = out[i];
+        int64_t a = (int64_t)((uint64_t)prev_at + (uint64_t)unzigzag(at.next()));   // Wraps on damaged input
+        uint64_t b = bt.next(), pr = priority.next(), jc = job_class.next(), ws = working_set.next();
+        in_range &= a >= 0 && (uint64_t)a <= int_max && b <= int_max && pr <= uint_max && jc <= uint_max &&
+                    ws <= int_max;
+        prev_at = a;
+        p.no = (int)(first_no + i);
+        p.at = (int)a;
+        p.bt = (int)b;
+        p.priority = (int)unzigzag(pr);
+        p.job_class = (int)unzigzag(jc);
+        p.working_set = (int)ws;
+        p.ct = 0;
+        p.tat = 0;
+        p.wt = 0;
+        p.progress = 0;
+        p.is_completed = false;
+    }
+    if (!at.ok() || !bt.ok() || !priority.ok() || !job_class.ok() || !working_set.ok()) return "damaged column";
+    if (!at.done() || !bt.done() || !priority.done() || !job_class.done() || !working_set.done()) {
+        return "column longer than its rows";
+    }
+    if (!in_range) return "value out of range";
+    return "";
+}
+
+bool read_header(const unsigned char* h, uint32_t& block_rows, uint64_t& rows) {
+    const unsigned char* p = h + 8;
+    uint32_t version = get_field<uint32_t>(p);
+    block_rows = get_field<uint32_t>(p);
+    rows = get_field<uint64_t>(p);
+    return memcmp(h, TRACE_MAGIC, 8) == 0 && version == TRACE_VERSION && block_rows > 0;
+}
+
+} // namespace
+
+bool is_compressed_trace(const string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char magic[8];
+    bool yes = fread(magic, 1, 8, f) == 8 && memcmp(magic, TRACE_MAGIC, 8) == 0;
+    fclose(f);
+    return yes;
+}
+
+// --- WRITER ---
+bool write_compressed_trace(const string& path, const vector<Proc>& procs, string& error, int block_rows) {
+    if (block_rows <= 0) block_rows = TRACE_BLOCK_ROWS;
+    for (size_t i = 0; i < procs.size(); ++i) {
+        if (procs[i].at < 0 || procs[i].bt < 0 || procs[i].working_set < 0) {
+            error = "process " + to_string(procs[i].no) + " has a negative arrival, burst or working set";
+            return false;
+        }
+    }
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    unsigned char header[HEADER_BYTES];
+    unsigned char* h = header;
+    memcpy(h, TRACE_MAGIC, 8);
+    h += 8;
+    put_field<uint32_t>(h, TRACE_VERSION);
+    put_field<uint32_t>(h, (uint32_t)block_rows);
+    put_field<uint64_t>(h, (uint64_t)procs.size());
+    bool ok = fwrite(header, 1, HEADER_BYTES, f) == HEADER_BYTES;
+
+    vector<unsigned char> columns[COLUMNS];
+    vector<unsigned char> block;
+    vector<unsigned char> index;
+    uint64_t offset = HEADER_BYTES;
+    for (size_t first = 0; ok && first < procs.size(); first += block_rows) {
+        uint32_t rows = (uint32_t)min((size_t)block_rows, procs.size() - first);
+        encode_block(&procs[first], rows, columns, block);
+        ok = fwrite(&block[0], 1, block.size(), f) == block.size();
+
+        unsigned char entry[INDEX_ENTRY_BYTES];
+        unsigned char* e = entry;
+        put_field<uint64_t>(e, offset);
+        put_field<uint32_t>(e, rows);
+        index.insert(index.end(), entry, entry + INDEX_ENTRY_BYTES);
+        offset += block.size();
+    }
+
+    unsigned char footer[FOOTER_BYTES];
+    unsigned char* t = footer;
+    put_field<uint64_t>(t, offset);
+    put_field<uint64_t>(t, (uint64_t)(index.size() / INDEX_ENTRY_BYTES));
+    memcpy(t, TRACE_END_MAGIC, 8);
+    if (ok && !index.empty()) ok = fwrite(&index[0], 1, index.size(), f) == index.size();
+    if (ok) ok = fwrite(footer, 1, FOOTER_BYTES, f) == FOOTER_BYTES;
+    if (fclose(f) != 0) ok = false;
+    if (!ok) error = "cannot write " + path;
+    return ok;
+}
+
+// --- PARALLEL READER ---
+bool read_compressed_trace(const string& path, vector<Proc>& procs, string& error, int threads) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        error = "cannot open " + path;
+        return false;
+    }
+    vector<unsigned char> file;
+    long long size = file_size(f);
+    bool read_ok = size >= 0 && (unsigned long long)size <= numeric_limits<size_t>::max();
+    if (read_ok && size > 0) {
+        file.resize((size_t)size);
+        read_ok = fread(&file[0], 1, file.size(), f) == file.size();
+    }
+    fclose(f);
+    if (!read_ok) {
+        error = "cannot read " + path;
+        return false;
+    }
+
+    uint32_t block_rows;
+    uint64_t rows;
+    if (file.size() < HEADER_BYTES + FOOTER_BYTES || !read_header(&file[0], block_rows, rows)) {
+        error = path + ": not a compressed trace of this version";
+        return false;
+    }
+    const unsigned char* t = &file[file.size() - FOOTER_BYTES];
+    uint64_t index_offset = get_field<uint64_t>(t);
+    uint64_t blocks = get_field<uint64_t>(t);
+    if (memcmp(t, TRACE_END_MAGIC, 8) != 0 || index_offset < HEADER_BYTES ||
+        index_offset > file.size() - FOOTER_BYTES ||
+        blocks != (file.size() - FOOTER_BYTES - index_offset) / INDEX_ENTRY_BYTES ||
+        (file.size() - FOOTER_BYTES - index_offset) % INDEX_ENTRY_BYTES != 0) {
+        error = path + ": truncated or damaged index";
+        return false;
+    }
+
+    // Block extents and where each block's rows go
+    vector<uint64_t> offsets(blocks + 1, index_offset), first_row(blocks + 1, 0);
+    vector<uint32_t> block_count(blocks);
+    const unsigned char* e = &file[index_offset];
+    for (uint64_t b = 0; b < blocks; ++b) {
+        offsets[b] = get_field<uint64_t>(e);
+        block_count[b] = get_field<uint32_t>(e);
+        first_row[b + 1] = first_row[b] + block_count[b];
+        if (offsets[b] < (b == 0 ? HEADER_BYTES : offsets[b - 1] + BLOCK_HEADER_BYTES) || offsets[b] > index_offset ||
+            block_count[b] > block_rows) {
+            error = path + ": truncated or damaged index";
+            return false;
+        }
+    }
+    if (first_row[blocks] != rows || rows > (uint64_t)numeric_limits<int>::max()) {
+        error = path + ": row count does not match the index";
+        return false;
+    }
+    if (rows == 0) {
+        error = path + ": no processes";
+        return false;
+    }
+    // Every row takes at least one byte per column, so a damaged row count
+    // cannot make us allocate far beyond the file
+    if (rows * COLUMNS > index_offset - HEADER_BYTES) {
+        error = path + ": row count does not match the block data";
+        return false;
+    }
+
+    procs.assign((size_t)rows, Proc());
+    int workers = threads > 0 ? threads : (int)thread::hardware_concurrency();
+    workers = (int)max<uint64_t>(1, min<uint64_t>(workers > 0 ? workers : 1, blocks));
+    atomic<uint64_t> next_block(0);
+    atomic<uint64_t> first_bad(blocks);
+    vector<string> problems(blocks);
+    auto work = [&]() {
+        for (uint64_t b; (b = next_block.fetch_add(1)) < blocks;) {
+            problems[b] = decode_block(&file[offsets[b]], offsets[b + 1] - offsets[b], block_count[b],
+                                       (long long)first_row[b] + 1, &procs[first_row[b]]);
+            if (!problems[b].empty()) {
+                uint64_t seen = first_bad.load();
+                while (b < seen && !first_bad.compare_exchange_weak(seen, b)) {}
+            }
+        }
+    };
+    vector<thread> pool;
+    for (int w = 1; w < workers; ++w) pool.push_back(thread(work));
+    work();
+    for (size_t w = 0; w < pool.size(); ++w) pool[w].join();
+
+    if (first_bad.load() < blocks) {
+        uint64_t b = first_bad.load();
+        error = path + ": block " + to_string(b) + " (rows " + to_string(first_row[b] + 1) + "+): " + problems[b];
+        return false;
+    }
+    return true;
+}
+
+// --- STREAMING READER ---
+CompressedTraceReader::CompressedTraceReader() : f_(0), rows_(0), block_rows_(0), count_(0), next_row_(0) {}
+
+CompressedTraceReader::~CompressedTraceReader() {
+    if (f_) fclose(f_);
+}
+
+bool CompressedTraceReader::open(const string& path, string& error) {
+    if (f_) fclose(f_);
+    f_ = fopen(path.c_str(), "rb");
+    path_ = path;
+    rows_ = 0;
+    block_rows_ = 0;
+    count_ = 0;
+    decoded_.clear();
+    next_row_ = 0;
+    if (!f_) {
+        error = "cannot open " + path;
+        return false;
+    }
+    unsigned char header[HEADER_BYTES];
+    uint32_t block_rows;
+    uint64_t rows;
+    if (fread(header, 1, HEADER_BYTES, f_) != HEADER_BYTES || !read_header(header, block_rows, rows)) {
+        error = path + ": not a compressed trace of this version";
+        return false;
+    }
+    rows_ = (long long)rows;
+    block_rows_ = block_rows;
+    return true;
+}
+
+bool CompressedTraceReader::next(Proc& p, string& error) {
+    if (next_row_ == decoded_.size()) {
+        // Blocks follow each other up to the index, so the row count says
+        // when to stop reading
+        if (!f_ || count_ >= rows_) {
+            error.clear();
+            return false;
+        }
+        unsigned char bh[BLOCK_HEADER_BYTES];
+        const unsigned char* h = bh;
+        bool ok = fread(bh, 1, BLOCK_HEADER_BYTES, f_) == BLOCK_HEADER_BYTES;
+        string problem = ok ? "" : "truncated block";
+        uint32_t rows = ok ? get_field<uint32_t>(h) : 0;
+        uint64_t bytes = BLOCK_HEADER_BYTES;
+        for (int c = 0; ok && c < COLUMNS; ++c) bytes += get_field<uint32_t>(h);
+        // Checked before allocating: 1 to MAX_VARINT_BYTES bytes per value
+        if (ok && (rows == 0 || rows > block_rows_ || (long long)rows > rows_ - count_ ||
+                   bytes - BLOCK_HEADER_BYTES < (uint64_t)rows * COLUMNS ||
+                   bytes - BLOCK_HEADER_BYTES > (uint64_t)rows * COLUMNS * MAX_VARINT_BYTES)) {
+            ok = false;
+            problem = "damaged block header";
+        }
+        if (ok) {
+            block_.resize((size_t)bytes);
+            memcpy(&block_[0], bh, BLOCK_HEADER_BYTES);
+            ok = fread(&block_[BLOCK_HEADER_BYTES], 1, block_.size() - BLOCK_HEADER_BYTES, f_) ==
+                 block_.size() - BLOCK_HEADER_BYTES;
+            if (!ok) problem = "truncated block";
+        }
+        if (ok) {
+            decoded_.resize(rows);
+            problem = decode_block(&block_[0], block_.size(), rows, count_ + 1, &decoded_[0]);
+        }
+        if (!problem.empty()) {
+            error = path_ + ": rows " + to_string(count_ + 1) + "+: " + problem;
+            fclose(f_);
+            f_ = 0;
+            return false;
+        }
+        next_row_ = 0;
+    }
+    p = decoded_[next_row_++];
+    ++count_;
+    return true;
+}
+
+// --- MENU ENTRY ---
+void run_trace_compression() {
+    cout << "\n<-- Compress a Trace File Selected -->" << endl;
+    string in, out;
+    cout << "Enter workload file to compress: ";
+    if (!(cin >> in)) {
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return;
+    }
+    cout << "Enter output file: ";
+    if (!(cin >> out)) {
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return;
+    }
+
+    vector<Proc> procs;
+    string error;
+    bool ok = load_workload_file(in, procs, error) && write_compressed_trace(out, procs, error);
+
+    vector<Proc> back;
+    double seconds = 0;
+    const int repeats = 5;
+    if (ok) {
+        // Best of a few decodes, so the file is in the page cache for all but the first
+        for (int r = 0; ok && r < repeats; ++r) {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            ok = read_compressed_trace(out, back, error);
+            double s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            if (r == 0 || s < seconds) seconds = s;
+        }
+    }
+    if (!ok) {
+        cout << "Could not compress the trace: " << error << endl;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "\nPress Enter to return to main menu...";
+        cin.get();
+        return;
+    }
+
+    long long in_bytes = 0, out_bytes = 0;
+    if (FILE* f = fopen(in.c_str(), "rb")) {
+        in_bytes = max(0LL, file_size(f));
+        fclose(f);
+    }
+    if (FILE* f = fopen(out.c_str(), "rb")) {
+        out_bytes = max(0LL, file_size(f));
+        fclose(f);
+    }
+    double raw_bytes = (double)procs.size() * 5 * sizeof(int);   // The five columns as plain ints
+    bool same = back.size() == procs.size();
+    for (size_t i = 0; same && i < procs.size(); ++i) {
+        same = back[i].at == procs[i].at && back[i].bt == procs[i].bt && back[i].priority == procs[i].priority &&
+               back[i].job_class == procs[i].job_class && back[i].working_set == procs[i].working_set;
+    }
+
+    clearScreen();
+    cout << "\n========================================================" << endl;
+    cout << "|| COMPRESSED TRACE ||" << endl;
+    cout << "========================================================" << endl;
+    cout << fixed << setprecision(2);
+    cout << "Processes:        " << procs.size() << " in "
+         << (procs.size() + TRACE_BLOCK_ROWS - 1) / TRACE_BLOCK_ROWS << " block(s)" << endl;
+    cout << "Text file:        " << in_bytes << " bytes" << endl;
+    cout << "Compressed:       " << out_bytes << " bytes ("
+         << (out_bytes > 0 ? (double)in_bytes / out_bytes : 0.0) << "x smaller than the text, "
+         << (out_bytes > 0 ? raw_bytes / out_bytes : 0.0) << "x smaller than 4-byte columns)" << endl;
+    cout << "Bytes per job:    " << (double)out_bytes / procs.size() << endl;
+    cout << "Decode:           " << seconds * 1000 << " ms on " << max(1u, thread::hardware_concurrency())
+         << " thread(s), " << (seconds > 0 ? raw_bytes / seconds / 1e9 : 0.0) << " GB/s of columns, "
+         << (seconds > 0 ? procs.size() / seconds / 1e6 : 0.0) << " M jobs/s" << endl;
+    cout << "Round trip:       " << (same ? "identical" : "MISMATCH") << endl;
+    cout << "Compressed traces load anywhere a workload file is asked for." << endl;
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
@@ -0,0 +1,64 @@
+#ifndef TRACE_CODEC_HPP
+#define TRACE_CODEC_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "scheduler_common.hpp"
+
+// Compressed workload traces for archival. Layout (native byte order):
+//   header  "SCHEDTZ1", u32 version, u32 rows per block, u64 rows
+//   blocks  u32 rows, u32 byte length of each of the 5 columns, then the
+//           columns: AT as the zigzag varint of the difference to the
+//           previous row (the first row of a block against 0), BT and WSS
+//           as varints, PRIORITY and CLASS as zigzag varints
+//   index   per block: u64 file offset, u32 rows
+//   footer  u64 index offset, u64 block count, "SCHEDTZE"
+// Every block decodes on its own, so a reader can stream the blocks in
+// order or hand them to several threads through the index. Traces whose
+// arrival times mostly increase and whose bursts are small take 1-2 bytes
+// per column instead of a text line or 4-byte integers.
+const int TRACE_BLOCK_ROWS = 65536;
+
+bool is_compressed_trace(const std::string& path);
+
+bool write_compressed_trace(const std::string& path, const std::vector<Proc>& procs, std::string& error,
+                            int block_rows = TRACE_BLOCK_ROWS);
+
+// Whole trace, blocks decoded in parallel (threads <= 0: hardware thread
+// count). Processes are numbered 1..n in trace order, as with text files.
+bool read_compressed_trace(const std::string& path, std::vector<Proc>& procs, std::string& error,
+                           int threads = 0);
+
+// One block at a time, for traces that should not be held in memory
+class CompressedTraceReader {
+public:
+    CompressedTraceReader();
+    ~CompressedTraceReader();
+
+    bool open(const std::string& path, std::string& error);
+
+    // False at the end of the trace or on a damaged block (error is set then)
+    bool next(Proc& p, std::string& error);
+
+    long long count() const { return count_; }
+
+private:
+    std::FILE* f_;
+    std::string path_;
+    long long rows_;           // In the whole trace
+    std::uint32_t block_rows_; // Most rows a block may hold
+    long long count_;          // Handed out so far
+    std::vector<unsigned char> block_;
+    std::vector<Proc> decoded_;
+    std::size_t next_row_;
+
+    CompressedTraceReader(const CompressedTraceReader&);
+    CompressedTraceReader& operator=(const CompressedTraceReader&);
+};
+
+// Menu entry: converts a workload file and reports size and decode speed
+void run_trace_compression();
+
+#endif // TRACE_CODEC_HPP
@@ -0,0 +1,229 @@
+#include "trace_export.hpp"
+#include "workload_io.hpp"
+#include "arrival_order.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+// Trace timestamps are microseconds
+static const long long US_PER_SECOND = 1000000;
+static const int ARRIVAL_TID = 0;   // CPU c is thread c + 1
+
+BufferedWriter::BufferedWriter(FILE* f) : f_(f), used_(0), failed_(false) {}
+
+BufferedWriter::~BufferedWriter() {
+    flush();
+}
+
+void BufferedWriter::write(const char* s) {
+    size_t len = strlen(s);
+    while (len) {
+        if (used_ == sizeof(buf_)) flush();
+        size_t n = min(len, sizeof(buf_) - used_);
+        memcpy(buf_ + used_, s, n);
+        used_ += n;
+        s += n;
+        len -= n;
+    }
+}
+
+void BufferedWriter::write_int(long long v) {
+    // "00" .. "99": two digits per division
+    static const char pairs[] =
+        "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+        "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+    if (used_ + 24 > sizeof(buf_)) flush();  // Longest value is 20 digits plus sign
+    char digits[24];
+    int len = 0;
+    unsigned long long u = v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+    while (u >= 100) {
+        unsigned r = (unsigned)(u % 100);
+        u /= 100;
+        digits[len++] = pairs[2 * r + 1];
+        digits[len++] = pairs[2 * r];
+    }
+    if (u >= 10) {
+        digits[len++] = pairs[2 * u + 1];
+        digits[len++] = pairs[2 * u];
+    } else {
+        digits[len++] = (char)('0' + u);
+    }
+    if (v < 0) buf_[used_++] = '-';
+    while (len) buf_[used_++] = digits[--len];
+}
+
+void BufferedWriter::flush() {
+    if (used_ && fwrite(buf_, 1, used_, f_) != used_) failed_ = true;
+    used_ = 0;
+}
+
+ChromeTraceWriter::ChromeTraceWriter(FILE* f, const vector<Proc>& procs, const string& title)
+    : out_(f), procs_(procs), events_(0), closed_(false) {
+    out_.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    out_.write("{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"args\":{\"name\":\"");
+    out_.write(title);
+    out_.write("\"}}");
+    track_name(ARRIVAL_TID, "Arrivals");
+}
+
+void ChromeTraceWriter::track_name(int tid, const string& name) {
+    out_.write(",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":");
+    out_.write_int(tid);
+    out_.write(",\"args\":{\"name\":\"");
+    out_.write(name);
+    out_.write("\"}}");
+}
+
+void ChromeTraceWriter::ensure_cpu(int cpu) {
+    while ((int)pending_.size() <= cpu) {
+        Segment none = {-1, 0, 0};
+        track_name((int)pending_.size() + 1, "CPU " + to_string(pending_.size()));
+        pending_.push_back(none);
+    }
+}
+
+// Opens an event object up to (but not including) its closing brace
+void ChromeTraceWriter::begin_event(const char* ph, const char* name_prefix, int idx, int tid, long long ts) {
+    out_.write(",\n{\"ph\":\"");
+    out_.write(ph);
+    out_.write("\",\"name\":\"");
+    out_.write(name_prefix);
+    out_.put('P');
+    out_.write_int(procs_[idx].no);
+    out_.write("\",\"pid\":1,\"tid\":");
+    out_.write_int(tid);
+    out_.write(",\"ts\":");
+    out_.write_int(ts * US_PER_SECOND);
+    events_++;
+}
+
+void ChromeTraceWriter::flush_segment(int cpu) {
+    Segment& s = pending_[cpu];
+    if (s.idx < 0) return;
+    begin_event("X", "", s.idx, cpu + 1, s.start);
+    out_.write(",\"dur\":");
+    out_.write_int((s.end - s.start) * US_PER_SECOND);
+    out_.write(",\"cat\":\"run\"}");
+    s.idx = -1;
+}
+
+void ChromeTraceWriter::on_arrival(int idx, long long t) {
+    begin_event("i", "Arrive ", idx, ARRIVAL_TID, t);
+    out_.write(",\"s\":\"t\",\"cat\":\"arrival\"}");
+}
+
+void ChromeTraceWriter::on_run(int cpu, int idx, long long start, long long end) {
+    ensure_cpu(cpu);
+    Segment& s = pending_[cpu];
+    if (s.idx == idx && s.end == start) {
+        s.end = end;  // Same job still on the CPU
+        return;
+    }
+    flush_segment(cpu);
+    s.idx = idx;
+    s.start = start;
+    s.end = end;
+}
+
+void ChromeTraceWriter::on_preempt(int cpu, int idx, long long t, PreemptReason why) {
+    ensure_cpu(cpu);
+    flush_segment(cpu);
+    begin_event("i", "Preempt ", idx, cpu + 1, t);
+    out_.write(",\"s\":\"t\",\"cat\":\"preempt\",\"args\":{\"reason\":\"");
+    out_.write(why == PREEMPT_QUANTUM ? "quantum expired" : "shorter job arrived");
+    out_.write("\"}}");
+}
+
+void ChromeTraceWriter::on_complete(int cpu, int idx, long long t, long long) {
+    ensure_cpu(cpu);
+    flush_segment(cpu);
+    begin_event("i", "Complete ", idx, cpu + 1, t);
+    out_.write(",\"s\":\"t\",\"cat\":\"complete\"}");
+}
+
+bool ChromeTraceWriter::close() {
+    if (!closed_) {
+        for (size_t c = 0; c < pending_.size(); ++c) flush_segment((int)c);
+        out_.write("\n]}\n");
+        out_.flush();
+        closed_ = true;
+    }
+    return !out_.failed();
+}
+
+bool export_chrome_trace(const vector<Proc>& procs, AlgoId algo, int quantum,
+                         const string& path, string& error, long long* events) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    bool ok;
+    {
+        ChromeTraceWriter writer(f, procs, "CPU Scheduler - " + algo_display_name(algo, quantum));
+        StreamEngine engine(algo, quantum);
+        engine.set_observer(&writer);
+
+        // StreamEngine takes arrivals in (at, index) order
+        vector<int> order = arrival_order(procs);
+        for (size_t i = 0; i < order.size(); ++i) engine.feed(procs[order[i]], order[i]);
+        engine.finish();
+
+        ok = writer.close();
+        if (events) *events = writer.events_written();
+    }
+    if (fclose(f) != 0) ok = false;
+    if (!ok) error = "write failed for " + path;
+    return ok;
+}
+
+void run_trace_export() {
+    cout << "\n<-- Chrome Trace Export Selected -->" << endl;
+    vector<Proc> procs;
+    if (!prompt_workload(procs)) {
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "\nPress Enter to return to main menu...";
+        cin.get();
+        return;
+    }
+
+    int choice;
+    cout << "Algorithm (1=FCFS, 2=SJF NP, 3=Priority NP, 4=SRTF, 5=RR): ";
+    if (!(cin >> choice) || choice < 1 || choice > 5) {
+        cout << "Invalid algorithm. Using FCFS." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        choice = 1;
+    }
+    AlgoId algo = (AlgoId)(choice - 1);
+
+    int quantum = 0;
+    if (algo == ALGO_RR) {
+        cout << "Enter Time Quantum (Q) for Round Robin: ";
+        if (!(cin >> quantum) || quantum <= 0) {
+            cout << "Invalid Time Quantum. Using Q=2 for RR." << endl;
+            cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            quantum = 2;
+        }
+    }
+
+    string path;
+    cout << "Output file (e.g. schedule.json): ";
+    cin >> path;
+
+    string error;
+    long long events = 0;
+    if (export_chrome_trace(procs, algo, quantum, path, error, &events)) {
+        cout << "\nWrote " << events << " trace events to " << path
+             << ". Open it in chrome://tracing or https://ui.perfetto.dev" << endl;
+    } else {
+        cout << "\nTrace export failed: " << error << endl;
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "\nPress Enter to return to main menu...";
+    cin.get();
+}
@@ -0,0 +1,82 @@
+#ifndef TRACE_EXPORT_HPP
+#define TRACE_EXPORT_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "scheduler_common.hpp"
+#include "stream_engine.hpp"
+
+// Fixed-size output buffer over a FILE*; memory use does not depend on how
+// much is written
+class BufferedWriter {
+public:
+    explicit BufferedWriter(std::FILE* f);
+    ~BufferedWriter();
+
+    void put(char c) {
+        if (used_ == sizeof(buf_)) flush();
+        buf_[used_++] = c;
+    }
+    void write(const char* s);
+    void write(const std::string& s) { write(s.c_str()); }
+    void write_int(long long v);
+    void flush();
+    bool failed() const { return failed_; }
+
+private:
+    std::FILE* f_;
+    char buf_[1 << 16];
+    std::size_t used_;
+    bool failed_;
+
+    BufferedWriter(const BufferedWriter&);
+    BufferedWriter& operator=(const BufferedWriter&);
+};
+
+// Streams a schedule as Chrome trace-event JSON (chrome://tracing, Perfetto).
+// Every CPU is a thread track with one duration event per run segment;
+// arrivals go on their own track, preemptions and completions are instant
+// events on the CPU track. One simulated second is shown as one second.
+class ChromeTraceWriter : public ScheduleObserver {
+public:
+    // procs supplies the display names (P<no>); it must outlive the writer
+    ChromeTraceWriter(std::FILE* f, const std::vector<Proc>& procs, const std::string& title);
+
+    void on_arrival(int idx, long long t);
+    void on_run(int cpu, int idx, long long start, long long end);
+    void on_preempt(int cpu, int idx, long long t, PreemptReason why);
+    void on_complete(int cpu, int idx, long long t, long long wt);
+
+    // Writes pending segments and the closing bracket
+    bool close();
+
+    long long events_written() const { return events_; }
+
+private:
+    struct Segment {
+        int idx;       // -1: none pending
+        long long start;
+        long long end;
+    };
+
+    void begin_event(const char* ph, const char* name_prefix, int idx, int tid, long long ts);
+    void track_name(int tid, const std::string& name);
+    void ensure_cpu(int cpu);
+    void flush_segment(int cpu);
+
+    BufferedWriter out_;
+    const std::vector<Proc>& procs_;
+    std::vector<Segment> pending_;   // Per CPU, merged while the same job keeps running
+    long long events_;
+    bool closed_;
+};
+
+// Runs `algo` over the workload with a ChromeTraceWriter attached
+bool export_chrome_trace(const std::vector<Proc>& procs, AlgoId algo, int quantum,
+                         const std::string& path, std::string& error, long long* events = 0);
+
+// Menu entry: pick a workload and an algorithm, write the trace file
+void run_trace_export();
+
+#endif // TRACE_EXPORT_HPP
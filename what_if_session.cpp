@@ -0,0 +1,186 @@
+#include "what_if_session.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+using namespace std;
+
+// Extremes cannot be patched after a partial replay, so the session drops them
+static AlgoResult averages_only(const AlgoResult& r) {
+    return {r.algo_name, r.avg_tat, r.avg_wt, 0, 0, 0, 0};
+}
+
+WhatIfSession::WhatIfSession(const vector<Proc>& procs, int quantum, int checkpoint_every)
+    : procs_(procs), fcfs_sum_ct_(0), sum_at_(0), sum_bt_(0), quantum_(quantum),
+      every_(checkpoint_every) {
+    int n = procs_.size();
+    if (every_ <= 0) {
+        // At most ~sqrt(n) checkpoints of ~sqrt(n) arrivals each, but not too fine-grained
+        every_ = max(256, (int)sqrt((double)n));
+    }
+
+    order_.resize(n);
+    for (int i = 0; i < n; ++i) {
+        order_[i] = i;
+        sum_at_ += procs_[i].at;
+        sum_bt_ += procs_[i].bt;
+    }
+    sort(order_.begin(), order_.end(), [this](int a, int b) { return arrives_before(a, b); });
+
+    results_.resize(ALGO_COUNT);
+    build_fcfs();
+    for (int a = ALGO_SJF_NP; a < ALGO_COUNT; ++a) build_track((AlgoId)a);
+}
+
+bool WhatIfSession::arrives_before(int a, int b) const {
+    if (procs_[a].at != procs_[b].at) return procs_[a].at < procs_[b].at;
+    return a < b;
+}
+
+// --- FCFS: prefix-max completion times ---
+void WhatIfSession::build_fcfs() {
+    int n = procs_.size();
+    fcfs_ct_.resize(n);
+    fcfs_sum_ct_ = 0;
+    long long current_time = 0;
+    for (int k = 0; k < n; ++k) {
+        const Proc& p = procs_[order_[k]];
+        current_time = max(current_time, (long long)p.at) + p.bt;
+        fcfs_ct_[k] = current_time;
+        fcfs_sum_ct_ += current_time;
+    }
+    store_fcfs_result();
+}
+
+// Recompute sorted positions lo.. until the schedule rejoins the old one after hi.
+// new_pos holds a placeholder that is not part of fcfs_sum_ct_ yet.
+void WhatIfSession::update_fcfs(int lo, int hi, int new_pos) {
+    int n = procs_.size();
+    long long current_time = lo > 0 ? fcfs_ct_[lo - 1] : 0;
+    for (int k = lo; k < n; ++k) {
+        const Proc& p = procs_[order_[k]];
+        long long ct = max(current_time, (long long)p.at) + p.bt;
+        if (k > hi && ct == fcfs_ct_[k]) break;  // Same start from here on: nothing else moves
+        if (k != new_pos) fcfs_sum_ct_ -= fcfs_ct_[k];
+        fcfs_sum_ct_ += ct;
+        fcfs_ct_[k] = ct;
+        current_time = ct;
+    }
+    store_fcfs_result();
+}
+
+void WhatIfSession::store_fcfs_result() {
+    int n = procs_.size();
+    if (n == 0) {
+        results_[ALGO_FCFS] = {"FCFS", 0.0, 0.0, 0, 0, 0, 0};
+        return;
+    }
+    double total_tat = (double)(fcfs_sum_ct_ - sum_at_);
+    double total_wt = (double)(fcfs_sum_ct_ - sum_at_ - sum_bt_);
+    results_[ALGO_FCFS] = {"FCFS", total_tat / n, total_wt / n, 0, 0, 0, 0};
+}
+
+// --- Checkpointed streaming engines ---
+// Each checkpoint pays for its queued jobs with the arrivals since the
+// previous one, which keeps the stored jobs of a track below n
+bool WhatIfSession::checkpoint_due(int previous, int position, const StreamEngine& engine) const {
+    int gap = position - previous;
+    return gap >= every_ && engine.queued() <= gap;
+}
+
+void WhatIfSession::build_track(AlgoId algo) {
+    Track& track = tracks_[algo];
+    int n = procs_.size();
+    StreamEngine engine(algo, quantum_);
+    track.checkpoints.assign(1, engine);
+    track.positions.assign(1, 0);
+    for (int k = 0; k < n; ++k) {
+        if (checkpoint_due(track.positions.back(), k, engine)) {
+            track.checkpoints.push_back(engine);
+            track.positions.push_back(k);
+        }
+        engine.feed(procs_[order_[k]], order_[k]);
+    }
+    engine.finish();
+    track.final_state = engine;
+    results_[algo] = averages_only(engine.result(n));
+}
+
+// Sorted positions lo..hi changed; checkpoints up to lo are still valid. The
+// replay places new checkpoints by the same rule and rejoins the old list at
+// the first old checkpoint past hi with the same state that the rule allows.
+void WhatIfSession::replay_track(AlgoId algo, int lo, int hi) {
+    Track& track = tracks_[algo];
+    int n = procs_.size();
+    int first = upper_bound(track.positions.begin(), track.positions.end(), lo) - track.positions.begin() - 1;
+    StreamEngine engine = track.checkpoints[first];
+    vector<StreamEngine> fresh;
+    vector<int> fresh_positions;
+    int last = track.positions[first];
+    size_t c = first + 1;   // Next old checkpoint
+
+    for (int k = track.positions[first]; k < n; ++k) {
+        if (c < track.positions.size() && track.positions[c] == k) {
+            StreamEngine& old_cp = track.checkpoints[c];
+            if (k > hi && checkpoint_due(last, k, engine) && engine.same_state(old_cp)) {
+                // Rejoined the old schedule: only the totals so far differ
+                double d_tat = engine.total_tat() - old_cp.total_tat();
+                double d_wt = engine.total_wt() - old_cp.total_wt();
+                for (size_t r = c; r < track.checkpoints.size(); ++r) {
+                    track.checkpoints[r].shift_totals(d_tat, d_wt);
+                }
+                track.final_state.shift_totals(d_tat, d_wt);
+                results_[algo] = averages_only(track.final_state.result(n));
+                track.checkpoints.erase(track.checkpoints.begin() + first + 1, track.checkpoints.begin() + c);
+                track.positions.erase(track.positions.begin() + first + 1, track.positions.begin() + c);
+                track.checkpoints.insert(track.checkpoints.begin() + first + 1, make_move_iterator(fresh.begin()),
+                                         make_move_iterator(fresh.end()));
+                track.positions.insert(track.positions.begin() + first + 1, fresh_positions.begin(), fresh_positions.end());
+                return;
+            }
+            ++c;
+        }
+        if (checkpoint_due(last, k, engine)) {
+            fresh.push_back(engine);
+            fresh_positions.push_back(k);
+            last = k;
+        }
+        engine.feed(procs_[order_[k]], order_[k]);
+    }
+    engine.finish();
+    track.checkpoints.resize(first + 1);
+    track.positions.resize(first + 1);
+    track.checkpoints.insert(track.checkpoints.end(), make_move_iterator(fresh.begin()), make_move_iterator(fresh.end()));
+    track.positions.insert(track.positions.end(), fresh_positions.begin(), fresh_positions.end());
+    track.final_state = engine;
+    results_[algo] = averages_only(engine.result(n));
+}
+
+void WhatIfSession::edit_process(int index, int at, int bt, int priority) {
+    int n = procs_.size();
+    if (index < 0 || index >= n) return;
+
+    // Move the job to its new place in arrival order
+    int old_pos = lower_bound(order_.begin(), order_.end(), index,
+                              [this](int a, int b) { return arrives_before(a, b); }) - order_.begin();
+
+    fcfs_sum_ct_ -= fcfs_ct_[old_pos];
+    order_.erase(order_.begin() + old_pos);
+    fcfs_ct_.erase(fcfs_ct_.begin() + old_pos);
+
+    sum_at_ += (long long)at - procs_[index].at;
+    sum_bt_ += (long long)bt - procs_[index].bt;
+    procs_[index].at = at;
+    procs_[index].bt = bt;
+    procs_[index].priority = priority;
+
+    int new_pos = lower_bound(order_.begin(), order_.end(), index,
+                              [this](int a, int b) { return arrives_before(a, b); }) - order_.begin();
+    order_.insert(order_.begin() + new_pos, index);
+    fcfs_ct_.insert(fcfs_ct_.begin() + new_pos, 0);
+
+    int lo = min(old_pos, new_pos);
+    int hi = max(old_pos, new_pos);
+    update_fcfs(lo, hi, new_pos);
+    for (int a = ALGO_SJF_NP; a < ALGO_COUNT; ++a) replay_track((AlgoId)a, lo, hi);
+}
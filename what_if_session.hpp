@@ -0,0 +1,65 @@
+#ifndef WHAT_IF_SESSION_HPP
+#define WHAT_IF_SESSION_HPP
+
+#include <vector>
+#include "scheduler_common.hpp"
+#include "comparison_tool.hpp"
+#include "stream_engine.hpp"
+
+// Keeps the last schedule of every algorithm so that editing one process
+// only recomputes the part of each schedule the edit can reach.
+//
+// FCFS keeps per-position completion times (a prefix-max scan) and rescans
+// from the edited position until the new completion times rejoin the old
+// ones. The other engines keep StreamEngine checkpoints, replay from the
+// checkpoint before the edit, and stop as soon as a later checkpoint shows
+// the same engine state as before the edit. Results always equal a fresh run
+// of the edited workload.
+//
+// A checkpoint copies the engine's ready queue, so checkpoints are spaced by
+// queue depth: one is taken at least `checkpoint_every` arrivals after the
+// previous one, and only once the arrivals since then are at least as many
+// as the queued jobs. The checkpoints of one engine therefore hold fewer
+// than n queued jobs in total, and an edit replays about max(interval, queue
+// depth) arrivals before it can stop.
+class WhatIfSession {
+public:
+    // checkpoint_every <= 0 picks a minimum interval from the workload size
+    WhatIfSession(const std::vector<Proc>& procs, int quantum, int checkpoint_every = 0);
+
+    // Replace process `index` (position in the original workload)
+    void edit_process(int index, int at, int bt, int priority);
+
+    // FCFS, SJF (NP), Priority (NP), SRTF (P), RR - same order as the comparison tool.
+    // Only the averages are maintained; the min/max fields are left at 0.
+    const std::vector<AlgoResult>& results() const { return results_; }
+    const std::vector<Proc>& processes() const { return procs_; }
+
+private:
+    struct Track {
+        std::vector<StreamEngine> checkpoints;
+        std::vector<int> positions;             // checkpoints[c] is the state after positions[c] arrivals
+        StreamEngine final_state;
+    };
+
+    bool arrives_before(int a, int b) const;
+    bool checkpoint_due(int previous, int position, const StreamEngine& engine) const;
+    void build_fcfs();
+    void update_fcfs(int lo, int hi, int new_pos);
+    void store_fcfs_result();
+    void build_track(AlgoId algo);
+    void replay_track(AlgoId algo, int lo, int hi);
+
+    std::vector<Proc> procs_;
+    std::vector<int> order_;           // Job indices in (at, index) order
+    std::vector<long long> fcfs_ct_;   // FCFS completion time per sorted position
+    long long fcfs_sum_ct_;
+    long long sum_at_;
+    long long sum_bt_;
+    int quantum_;
+    int every_;
+    Track tracks_[ALGO_COUNT];         // FCFS slot unused
+    std::vector<AlgoResult> results_;
+};
+
+#endif // WHAT_IF_SESSION_HPP
@@ -0,0 +1,185 @@
+#include "workload_io.hpp"
+#include "trace_codec.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#ifdef __linux__
+    #include <fcntl.h>
+#endif
+
+using namespace std;
+
+// Parses up to `max_fields` integers; returns how many were found
+static int parse_fields(const char* line, long long* fields, int max_fields, bool& junk) {
+    int count = 0;
+    junk = false;
+    const char* s = line;
+    while (*s) {
+        while (*s == ' ' || *s == '\t' || *s == ',' || *s == '\r' || *s == '\n') ++s;
+        if (!*s) break;
+        char* end;
+        long long v = strtoll(s, &end, 10);
+        if (end == s) {
+            junk = true;
+            break;
+        }
+        if (count < max_fields) fields[count] = v;
+        ++count;
+        s = end;
+    }
+    return count;
+}
+
+static Proc make_proc(int no, int at, int bt, int priority, int job_class, int working_set) {
+    Proc p;
+    p.no = no;
+    p.at = at;
+    p.bt = bt;
+    p.priority = priority;
+    p.job_class = job_class;
+    p.working_set = working_set;
+    p.ct = 0;
+    p.tat = 0;
+    p.wt = 0;
+    p.progress = 0;
+    p.is_completed = false;
+    return p;
+}
+
+WorkloadReader::WorkloadReader() : f_(0), line_no_(0), count_(0) {}
+
+WorkloadReader::~WorkloadReader() {
+    if (f_) fclose(f_);
+}
+
+bool WorkloadReader::open(const string& path, string& error, size_t buffer_bytes) {
+    if (f_) fclose(f_);
+    f_ = 0;
+    path_ = path;
+    line_no_ = 0;
+    count_ = 0;
+    packed_.reset();
+    if (is_compressed_trace(path)) {
+        packed_.reset(new CompressedTraceReader());
+        return packed_->open(path, error);
+    }
+    f_ = fopen(path.c_str(), "r");
+    if (!f_) {
+        error = "cannot open " + path;
+        return false;
+    }
+    if (buffer_bytes > 0) {
+        buffer_.resize(buffer_bytes);
+        setvbuf(f_, &buffer_[0], _IOFBF, buffer_bytes);
+#ifdef __linux__
+        posix_fadvise(fileno(f_), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+    return true;
+}
+
+// One whole line into line_, however long (fgets alone would split it), NUL
+// bytes included. fgets does not say how much it read: the chunk is filled
+// with '\n' first, and as nothing follows a newline, the last byte that is
+// not '\n' is the terminator fgets wrote.
+bool WorkloadReader::read_line() {
+    line_.clear();
+    char chunk[256];
+    for (;;) {
+        memset(chunk, '\n', sizeof(chunk));
+        if (!fgets(chunk, sizeof(chunk), f_)) break;
+        size_t len = sizeof(chunk) - 1;
+        while (chunk[len] == '\n') --len;
+        line_.append(chunk, len);
+        if (len > 0 && chunk[len - 1] == '\n') return true;
+    }
+    return !line_.empty();
+}
+
+bool WorkloadReader::next(Proc& p, string& error) {
+    if (packed_) {
+        if (!packed_->next(p, error)) return false;
+        line_no_ = count_ = packed_->count();
+        return true;
+    }
+    while (f_ && read_line()) {
+        ++line_no_;
+        if (line_.find('\0') != string::npos) {
+            error = path_ + ":" + to_string(line_no_) + ": NUL byte in line";
+            return false;
+        }
+        const char* s = line_.c_str();
+        while (*s == ' ' || *s == '\t') ++s;
+        if (*s == '#' || *s == '\n' || *s == '\r' || *s == '\0') continue;
+
+        long long v[5] = {0, 0, 0, 0, 0};
+        bool junk;
+        int count = parse_fields(s, v, 5, junk);
+        if (junk || count < 2 || count > 5 || v[0] < 0 || v[1] < 0 || v[4] < 0 ||
+            v[0] > numeric_limits<int>::max() || v[1] > numeric_limits<int>::max() ||
+            v[2] < numeric_limits<int>::min() || v[2] > numeric_limits<int>::max() ||
+            v[3] < numeric_limits<int>::min() || v[3] > numeric_limits<int>::max() ||
+            v[4] > numeric_limits<int>::max()) {
+            error = path_ + ":" + to_string(line_no_) + ": expected \"AT BT [PRIORITY [CLASS [WSS]]]\"";
+            return false;
+        }
+        p = make_proc((int)++count_, (int)v[0], (int)v[1], (int)v[2], (int)v[3], (int)v[4]);
+        return true;
+    }
+    error.clear();
+    return false;
+}
+
+bool load_workload_file(const string& path, vector<Proc>& procs, string& error) {
+    if (is_compressed_trace(path)) return read_compressed_trace(path, procs, error);
+    WorkloadReader reader;
+    if (!reader.open(path, error)) return false;
+    procs.clear();
+
+    Proc p;
+    while (reader.next(p, error)) procs.push_back(p);
+    if (!error.empty()) return false;
+    if (procs.empty()) {
+        error = path + ": no processes";
+        return false;
+    }
+    return true;
+}
+
+bool prompt_workload(vector<Proc>& procs) {
+    string path;
+    cout << "Enter workload file (AT BT [PRIORITY] per line), or - to type processes: ";
+    if (!(cin >> path)) {
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return false;
+    }
+
+    if (path != "-") {
+        string error;
+        if (!load_workload_file(path, procs, error)) {
+            cout << "Could not load workload: " << error << endl;
+            return false;
+        }
+        cout << "Loaded " << procs.size() << " processes from " << path << "." << endl;
+        return true;
+    }
+
+    int n;
+    cout << "Enter Number of Processes: ";
+    if (!(cin >> n) || n <= 0) {
+        cout << "Invalid number of processes." << endl;
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return false;
+    }
+    procs.clear();
+    for (int i = 0; i < n; ++i) {
+        Proc p = read_proc(i + 1);
+        cout << "Enter Priority (lower number = higher priority): ";
+        cin >> p.priority;
+        procs.push_back(p);
+    }
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef WORKLOAD_IO_HPP
+#define WORKLOAD_IO_HPP
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "scheduler_common.hpp"
+
+// Plain-text workload files: one process per line, "AT BT [PRIORITY [CLASS [WSS]]]",
+// separated by spaces, tabs or commas. CLASS groups jobs whose bursts are
+// alike (e.g. the same recurring process) for burst prediction. WSS is the
+// working-set size in KB, which multi-core runs charge when a job migrates.
+// Blank lines and lines starting with '#' are skipped. Processes are numbered 1..n in file order.
+// Compressed traces (trace_codec.hpp) are recognised by their header and
+// read in place of text.
+bool load_workload_file(const std::string& path, std::vector<Proc>& procs, std::string& error);
+
+class CompressedTraceReader;
+
+// Reads a workload file one process at a time, for traces that should not be
+// held in memory. Compressed traces are decoded a block at a time.
+class WorkloadReader {
+public:
+    WorkloadReader();
+    ~WorkloadReader();
+
+    // buffer_bytes > 0 reads the file in blocks of that size, announced to
+    // the OS as a sequential scan (for traces far larger than RAM)
+    bool open(const std::string& path, std::string& error, std::size_t buffer_bytes = 0);
+
+    // False at the end of the file or on a malformed line (error is set then)
+    bool next(Proc& p, std::string& error);
+
+    long long line() const { return line_no_; }   // Row number for compressed traces
+    long long count() const { return count_; }
+
+private:
+    bool read_line();
+
+    std::FILE* f_;
+    std::vector<char> buffer_;
+    std::string line_;
+    std::string path_;
+    long long line_no_;
+    long long count_;
+    std::unique_ptr<CompressedTraceReader> packed_;
+
+    WorkloadReader(const WorkloadReader&);
+    WorkloadReader& operator=(const WorkloadReader&);
+};
+
+// Asks for a workload file, or for the processes one by one when the user
+// enters '-'. Returns false (after printing why) when nothing usable was read.
+bool prompt_workload(std::vector<Proc>& procs);
+
+#endif // WORKLOAD_IO_HPP